@@ -3,22 +3,86 @@
 #include <math.h>
 #include <string.h>
 #include "MT_random.h"
+#include "MT_random_internal.h"
 
-#define INT_STATELENGTH (1+2*9+312*17+1)
 #define UNIFORM_STATELENGTH (1+2*17+1+INT_STATELENGTH)
 #define GAUSS_STATELENGTH (1+4*17+9+1+(UNIFORM_STATELENGTH))
 
-#define NN (MTSTATESIZE)
-#define MM 0x000000000000009C
-#define UM 0xFFFFFFFF80000000
-#define LM 0x000000007FFFFFFF
-
 #define INV2POW53MIN1 (1.0/((double)0x001FFFFFFFFFFFFF))
+#define INV2POW24 (1.0f/16777216.0f)
+// bits of 1.0, or-ed to the upper 52 bits of a number give a double in [1,2)
+#define EXPONENTONE 0x3FF0000000000000ul
+
+#define GAUSS_BUFFERLENGTH 256
+
+// link symbol of the state layout, see MT_RANDOM_ABI
+const int MT_RANDOM_ABI = 1;
 
 const long int mag[2] = {0x0000000000000000, 0xB5026F5AA96619E9} ;
 
 const double twopi = 6.28318530717958647692528676655900559 ;
 
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a int random number generator in place
+//    Can also be used to reseed an existing state.
+// Variables:
+//    rng_int: int random number state to initialize
+//    seed: The seed
+/////////////////////////////////////////////////////////////////////////////
+void init_rng_int_inplace(rng_int_type* rng_int, int seed){
+   rng_int->seed = seed;
+   rng_int->mtstate[0] = seed ;
+   for (int i=1; i<NN; i++){
+      rng_int->mtstate[i] = 0x5851F42D4C957F2D * 
+         (rng_int->mtstate[i-1]^(((unsigned long int)rng_int->mtstate[i-1])>>62)) + i;
+   } 
+   rng_int->mtidx = NN+1;
+   reset_instrument(rng_int);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a int random number generator in place from an array of
+//    64 bit keys with the init_by_array64 scheme of the reference
+//    MT19937-64 implementation. The seed member holds the lower 32 bits
+//    of the first key.
+// Variables:
+//    rng_int: int random number state to initialize
+//    key: array of keys
+//    keylength: number of keys, has to be positive
+/////////////////////////////////////////////////////////////////////////////
+void init_rng_int_by_array64(rng_int_type* rng_int, const uint64_t* key, size_t keylength){
+   if (keylength == 0){
+      fprintf(stderr, "Error in initializing random number generator from an empty key.");
+      abort();
+   }
+
+   unsigned long int* mtstate = (unsigned long int*) rng_int->mtstate;
+   init_rng_int_inplace(rng_int, 19650218);
+
+   size_t i = 1;
+   size_t j = 0;
+   for (size_t k = NN > keylength ? NN : keylength; k > 0; k--){
+      mtstate[i] = (mtstate[i] ^ ((mtstate[i-1] ^ (mtstate[i-1]>>62)) * 0x369DEA0F31A53F85))
+                   + key[j] + j;
+      i++;
+      j++;
+      if (i >= NN) {mtstate[0] = mtstate[NN-1]; i = 1;}
+      if (j >= keylength) {j = 0;}
+   }
+   for (size_t k = NN-1; k > 0; k--){
+      mtstate[i] = (mtstate[i] ^ ((mtstate[i-1] ^ (mtstate[i-1]>>62)) * 0x27BB2EE687B0B0FD)) - i;
+      i++;
+      if (i >= NN) {mtstate[0] = mtstate[NN-1]; i = 1;}
+   }
+   mtstate[0] = 1ul << 63;
+
+   rng_int->seed = (int) key[0];
+   rng_int->mtidx = NN+1;
+   reset_instrument(rng_int);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Description:
 //    Initializes a int random number generator
@@ -29,16 +93,25 @@ const double twopi = 6.28318530717958647692528676655900559 ;
 /////////////////////////////////////////////////////////////////////////////
 rng_int_type init_rng_int(int seed){
    rng_int_type rng_int;
-   rng_int.seed = seed;
-   rng_int.mtstate[0] = seed ;
-   for (int i=1; i<NN; i++){
-      rng_int.mtstate[i] = 0x5851F42D4C957F2D * 
-         (rng_int.mtstate[i-1]^(((unsigned long int)rng_int.mtstate[i-1])>>62)) + i;
-   } 
-   rng_int.mtidx = NN+1;
+   init_rng_int_inplace(&rng_int, seed);
    return rng_int;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a uniform random number generator in place
+// Variables:
+//    rng_uniform: uniform random number state to initialize
+//    seed: The seed
+//    lower: lower bound of random numbers
+//    upper: upper bound of random numbers
+/////////////////////////////////////////////////////////////////////////////
+void init_rng_uniform_inplace(rng_uniform_type* rng_uniform, int seed, double lower, double upper){
+   init_rng_int_inplace(&rng_uniform->rng_int, seed);
+   rng_uniform->lower = lower;
+   rng_uniform->upper = upper;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Description:
 //    Initializes a uniform random number generator
@@ -51,13 +124,28 @@ rng_int_type init_rng_int(int seed){
 /////////////////////////////////////////////////////////////////////////////
 rng_uniform_type init_rng_uniform(int seed, double lower, double upper){
    rng_uniform_type rng_uniform;
-
-   rng_uniform.rng_int = init_rng_int(seed);
-   rng_uniform.lower = lower;
-   rng_uniform.upper = upper;
+   init_rng_uniform_inplace(&rng_uniform, seed, lower, upper);
    return rng_uniform;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a gaussian random number generator in place
+// Variables:
+//    rng_gaussian: gaussian random number state to initialize
+//    seed: The seed
+//    mean: Mean value of the gaussian
+//    stddev: standard deviation of the gaussian
+/////////////////////////////////////////////////////////////////////////////
+void init_rng_gaussian_inplace(rng_gaussian_type* rng_gaussian, int seed, double mean, double stddev){
+   init_rng_uniform_inplace(&rng_gaussian->rng_uniform, seed, 0.0, 1.0);
+   rng_gaussian->mean = mean;
+   rng_gaussian->stddev = stddev;
+   rng_gaussian->z1 = 0.0;
+   rng_gaussian->z2 = 0.0;
+   rng_gaussian->generated = false;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Description:
 //    Initializes a gaussian random number generator
@@ -70,56 +158,160 @@ rng_uniform_type init_rng_uniform(int seed, double lower, double upper){
 /////////////////////////////////////////////////////////////////////////////
 rng_gaussian_type init_rng_gaussian(int seed, double mean, double stddev){
    rng_gaussian_type rng_gaussian;
-
-   rng_gaussian.rng_uniform = init_rng_uniform(seed, 0.0, 1.0);
-   rng_gaussian.mean = mean;
-   rng_gaussian.stddev = stddev;
-   rng_gaussian.z1 = 0.0;
-   rng_gaussian.z2 = 0.0;
-   rng_gaussian.generated = false;
+   init_rng_gaussian_inplace(&rng_gaussian, seed, mean, stddev);
    return rng_gaussian;
 }
 
 /////////////////////////////////////////////////////////////////////////////
 // Description:
-//    Generates the next int random number
+//    Initializes a 32 bit int random number generator in place
 // Variables:
-//    rng_int: Random number generator state
+//    rng_int32: 32 bit int random number state to initialize
+//    seed: The seed
+/////////////////////////////////////////////////////////////////////////////
+void init_rng_int32_inplace(rng_int32_type* rng_int32, int seed){
+   init_rng_int_inplace(&rng_int32->rng_int, seed);
+   rng_int32->buffered = false;
+   rng_int32->buffer = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a 32 bit int random number generator
+// Variables:
+//    seed: The seed
 // Return value:
-//    randnum: next random number
+//    rng_int32: 32 bit int random number state
 /////////////////////////////////////////////////////////////////////////////
-long int next_random_lint(rng_int_type* rng_int){
+rng_int32_type init_rng_int32(int seed){
+   rng_int32_type rng_int32;
+   init_rng_int32_inplace(&rng_int32, seed);
+   return rng_int32;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a single precision uniform random number generator in place
+// Variables:
+//    rng_float: single precision uniform random number state to initialize
+//    seed: The seed
+//    lower: lower bound of random numbers
+//    upper: upper bound of random numbers
+/////////////////////////////////////////////////////////////////////////////
+void init_rng_float_inplace(rng_float_type* rng_float, int seed, float lower, float upper){
+   init_rng_int32_inplace(&rng_float->rng_int32, seed);
+   rng_float->lower = lower;
+   rng_float->upper = upper;
+}
 
-   unsigned long int rng = 0;
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a single precision uniform random number generator
+// Variables:
+//    seed: The seed
+//    lower: lower bound of random numbers
+//    upper: upper bound of random numbers
+// Return value:
+//    rng_float: single precision uniform random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_float_type init_rng_float(int seed, float lower, float upper){
+   rng_float_type rng_float;
+   init_rng_float_inplace(&rng_float, seed, lower, upper);
+   return rng_float;
+}
 
-   // if pool of random numbers is drained create a set of new ones
-   if (rng_int->mtidx > NN-2){
-      for (int i=0; i<NN-MM; i++) {
-         rng = (rng_int->mtstate[i] & UM) ^ (rng_int->mtstate[i+1] & LM);
-         rng_int->mtstate[i] = (rng_int->mtstate[i+MM] ^ (rng>>1)) ^ (mag[(rng& 1)]) ;
-      }
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reseeds a uniform random number generator, the bounds are kept
+// Variables:
+//    rng_uniform: uniform random number state
+//    seed: The seed
+/////////////////////////////////////////////////////////////////////////////
+void reseed_rng_uniform(rng_uniform_type* rng_uniform, int seed){
+   init_rng_int_inplace(&rng_uniform->rng_int, seed);
+}
 
-      for (int i=NN-MM; i<NN-1; i++) {
-         rng = (rng_int->mtstate[i] & UM) ^ (rng_int->mtstate[i+1] & LM);
-         rng_int->mtstate[i] = (rng_int->mtstate[i+MM-NN] ^ (rng>>1)) ^ (mag[(rng& 1)]) ;
-      }
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reseeds a gaussian random number generator, mean value and standard
+//    deviation are kept and a pending second Box-Muller number is dropped
+// Variables:
+//    rng_gaussian: gaussian random number state
+//    seed: The seed
+/////////////////////////////////////////////////////////////////////////////
+void reseed_rng_gaussian(rng_gaussian_type* rng_gaussian, int seed){
+   init_rng_int_inplace(&rng_gaussian->rng_uniform.rng_int, seed);
+   rng_gaussian->generated = false;
+}
 
-      rng = (rng_int->mtstate[NN-1] & UM) ^ (rng_int->mtstate[0] & LM);
-      rng_int->mtstate[NN-1] = (rng_int->mtstate[MM-1] ^ (rng>>1)) ^ (mag[(rng& 1)]) ;
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reseeds a uniform random number generator from an array of 64 bit
+//    keys, the bounds are kept
+// Variables:
+//    rng_uniform: uniform random number state
+//    key: array of keys
+//    keylength: number of keys, has to be positive
+/////////////////////////////////////////////////////////////////////////////
+void reseed_rng_uniform_by_array64(rng_uniform_type* rng_uniform, const uint64_t* key, size_t keylength){
+   init_rng_int_by_array64(&rng_uniform->rng_int, key, keylength);
+}
 
-      rng_int->mtidx = -1 ;
-   }
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reseeds a gaussian random number generator from an array of 64 bit
+//    keys, mean value and standard deviation are kept and a pending second
+//    Box-Muller number is dropped
+// Variables:
+//    rng_gaussian: gaussian random number state
+//    key: array of keys
+//    keylength: number of keys, has to be positive
+/////////////////////////////////////////////////////////////////////////////
+void reseed_rng_gaussian_by_array64(rng_gaussian_type* rng_gaussian, const uint64_t* key, size_t keylength){
+   init_rng_int_by_array64(&rng_gaussian->rng_uniform.rng_int, key, keylength);
+   rng_gaussian->generated = false;
+}
 
-   // get a number from stack and mix it up to produce the final random number
-   rng_int->mtidx += 1 ;
-   rng = rng_int->mtstate[rng_int->mtidx] ;
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in the mersenne twister state
+//    and resets the index
+// Variables:
+//    rng_int: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+void regenerate_rng_int(rng_int_type* rng_int){
+   uint64_t start = read_instrument_cycles();
+   regenerate_mtstate(rng_int->mtstate);
+   rng_int->mtidx = -1 ;
+   count_instrument_twist(rng_int, start);
+}
 
-   rng = (rng) ^ ((rng>>29) & 0x5555555555555555) ;
-   rng = (rng) ^ ((rng<<17) & 0x71d67fffeda60000) ;
-   rng = (rng) ^ ((rng<<37) & 0xfff7eee000000000) ;
-   rng = (rng) ^  (rng>>43) ;
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Makes sure the state holds at least one unused number and returns how
+//    many consecutive unused numbers follow mtidx in the current state
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    navail: number of directly available random numbers
+/////////////////////////////////////////////////////////////////////////////
+static inline int available_rng_int(rng_int_type* rng_int){
+   if (rng_int->mtidx > NN-2){
+      regenerate_rng_int(rng_int);
+   }
+   return NN-1 - rng_int->mtidx;
+}
 
-   return (long int) rng;
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next int random number
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+long int next_random_lint(rng_int_type* rng_int){
+   return next_random_lint_inline(rng_int);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -131,7 +323,7 @@ long int next_random_lint(rng_int_type* rng_int){
 //    randnum: next random number
 /////////////////////////////////////////////////////////////////////////////
 int next_random_int(rng_int_type* rng_int){
-   return (int) ((unsigned long int)next_random_lint(rng_int)>>32);
+   return next_random_int_inline(rng_int);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -143,11 +335,27 @@ int next_random_int(rng_int_type* rng_int){
 //    randnum: next random number
 /////////////////////////////////////////////////////////////////////////////
 double next_random_uniform(rng_uniform_type* rng_uniform){
-   unsigned long int irng = next_random_lint(&rng_uniform->rng_int);
-   double randnum = INV2POW53MIN1 * (double)(irng>>11);
-   randnum *= rng_uniform->upper - rng_uniform->lower;
-   randnum += rng_uniform->lower;
-   return randnum;
+   return next_random_uniform_inline(rng_uniform);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Performs the Box-Muller transform on two uniform random numbers
+//    and stores the resulting pair in the gaussian state
+// Variables:
+//    rng_gaussian: Random number generator state
+//    u1: first uniform random number in (0,1]
+//    u2: second uniform random number in [0,1]
+/////////////////////////////////////////////////////////////////////////////
+static inline void box_muller_rng_gaussian(rng_gaussian_type* rng_gaussian,
+                                           double u1, double u2){
+   uint64_t start = read_instrument_cycles();
+   double tmp1 = sqrt(-2.0*log(u1));
+   double tmp2 = twopi*u2;
+   rng_gaussian->z1 = tmp1*cos(tmp2);
+   rng_gaussian->z2 = tmp1*sin(tmp2);
+   rng_gaussian->generated = true;
+   count_instrument_transform(&rng_gaussian->rng_uniform.rng_int, start);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -172,16 +380,504 @@ double next_random_gaussian(rng_gaussian_type* rng_gaussian){
       u2 = next_random_uniform(&rng_gaussian->rng_uniform);
    }
 
-   double tmp1 = sqrt(-2.0*log(u1));
-   double tmp2 = twopi*u2;
-   rng_gaussian->z1 = tmp1*cos(tmp2);
-   rng_gaussian->z2 = tmp1*sin(tmp2);
-   rng_gaussian->generated = true;
+   box_muller_rng_gaussian(rng_gaussian, u1, u2);
    
    return rng_gaussian->z1 * rng_gaussian->stddev + rng_gaussian->mean;
    
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Aborts if a range for bounded integers is empty
+// Variables:
+//    range: number of possible values
+/////////////////////////////////////////////////////////////////////////////
+static void check_range(uint64_t range){
+   if (range == 0){
+      fprintf(stderr, "Error in generating a random number in an empty range.");
+      abort();
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Maps a 64 bit random number to [0,range) with a multiply-shift.
+//    The lower half of the product tells whether the number belongs to
+//    the 2^64 % range values that would make the result biased.
+// Variables:
+//    randnum: 64 bit random number
+//    range: number of possible values
+//    threshold: (2^64-range) % range
+//    result: number in [0,range)
+// Return value:
+//    accepted: Boolean if the number can be used
+/////////////////////////////////////////////////////////////////////////////
+static inline bool map_range(uint64_t randnum, uint64_t range, uint64_t threshold,
+                             uint64_t* result){
+   unsigned __int128 product = (unsigned __int128) randnum * range;
+   *result = (uint64_t) (product >> 64);
+   return (uint64_t) product >= threshold;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Continues next_random_range after a product with a lower half below
+//    range, only then the exact threshold is needed. Kept out of line so
+//    the common path stays short.
+// Variables:
+//    rng_int: Random number generator state
+//    range: number of possible values
+//    product: product of the last random number and range
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((noinline, cold))
+static uint64_t next_random_range_rejected(rng_int_type* rng_int, uint64_t range,
+                                           unsigned __int128 product){
+   uint64_t threshold = (0-range) % range;
+   while ((uint64_t) product < threshold){
+      product = (unsigned __int128) (uint64_t) next_random_lint(rng_int) * range;
+   }
+   return (uint64_t) (product >> 64);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next unbiased integer random number in [0,range)
+// Variables:
+//    rng_int: Random number generator state
+//    range: number of possible values, has to be positive
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+uint64_t next_random_range(rng_int_type* rng_int, uint64_t range){
+   check_range(range);
+
+   // a power of two divides 2^64, so the upper bits are unbiased
+   if ((range & (range-1)) == 0){
+      uint64_t randnum = (uint64_t) next_random_lint(rng_int);
+      return range == 1 ? 0 : randnum >> (64 - __builtin_ctzl(range));
+   }
+
+   unsigned __int128 product = (unsigned __int128) (uint64_t) next_random_lint(rng_int) * range;
+   if ((uint64_t) product < range){
+      return next_random_range_rejected(rng_int, range, product);
+   }
+   return (uint64_t) (product >> 64);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next 32 bit int random number. The upper half of a
+//    64 bit number is returned first, the lower half on the next call.
+// Variables:
+//    rng_int32: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+int next_random_int32(rng_int32_type* rng_int32){
+   if (rng_int32->buffered){
+      rng_int32->buffered = false;
+      return (int) rng_int32->buffer;
+   }
+
+   unsigned long int irng = next_random_lint(&rng_int32->rng_int);
+   rng_int32->buffer = (unsigned int) irng;
+   rng_int32->buffered = true;
+   return (int) (irng>>32);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Converts the upper 24 bits of a 32 bit random number to [0,1)
+// Variables:
+//    irng: 32 bit random number
+// Return value:
+//    randnum: random number in [0,1)
+/////////////////////////////////////////////////////////////////////////////
+static inline float float_rng_int32(unsigned int irng){
+   return INV2POW24 * (float)(irng>>8);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next single precision uniform random number
+// Variables:
+//    rng_float: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+float next_random_float(rng_float_type* rng_float){
+   float randnum = float_rng_int32((unsigned int) next_random_int32(&rng_float->rng_int32));
+   randnum *= rng_float->upper - rng_float->lower;
+   randnum += rng_float->lower;
+   return randnum;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next long int random numbers
+//    The numbers are identical to n consecutive calls of next_random_lint
+// Variables:
+//    rng_int: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_lint(rng_int_type* rng_int, long int* randnums, size_t n){
+   while (n > 0){
+      size_t nblock = (size_t) available_rng_int(rng_int);
+      if (nblock > n) {nblock = n;}
+
+      temper_mtstate(rng_int->mtstate + rng_int->mtidx + 1, randnums, nblock);
+
+      rng_int->mtidx += (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next int random numbers
+//    The numbers are identical to n consecutive calls of next_random_int
+// Variables:
+//    rng_int: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_int(rng_int_type* rng_int, int* randnums, size_t n){
+   while (n > 0){
+      size_t nblock = (size_t) available_rng_int(rng_int);
+      if (nblock > n) {nblock = n;}
+
+      const long int* mtstate = rng_int->mtstate + rng_int->mtidx + 1;
+      for (size_t i=0; i<nblock; i++){
+         randnums[i] = (int) (temper_rng_int(mtstate[i])>>32);
+      }
+
+      rng_int->mtidx += (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next uniform random numbers
+//    The numbers are identical to n consecutive calls of next_random_uniform
+// Variables:
+//    rng_uniform: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_uniform(rng_uniform_type* rng_uniform, double* randnums, size_t n){
+   rng_int_type* rng_int = &rng_uniform->rng_int;
+   const double width = rng_uniform->upper - rng_uniform->lower;
+   const double lower = rng_uniform->lower;
+
+   while (n > 0){
+      size_t nblock = (size_t) available_rng_int(rng_int);
+      if (nblock > n) {nblock = n;}
+
+      const long int* mtstate = rng_int->mtstate + rng_int->mtidx + 1;
+      for (size_t i=0; i<nblock; i++){
+         double randnum = INV2POW53MIN1 * (double)(temper_rng_int(mtstate[i])>>11);
+         randnum *= width;
+         randnum += lower;
+         randnums[i] = randnum;
+      }
+
+      rng_int->mtidx += (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with x*scale+offset for the next random numbers, where
+//    x in [1,2) is built from the upper 52 bits of a number
+// Variables:
+//    rng_uniform: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+//    onebits: exponent bits of 1.0, optionally with the lowest mantissa bit
+//    scale: factor of x
+//    offset: summand of x*scale
+/////////////////////////////////////////////////////////////////////////////
+static void fill_random_uniform_exponent(rng_uniform_type* rng_uniform, double* randnums, size_t n,
+                                         unsigned long int onebits, double scale, double offset){
+   rng_int_type* rng_int = &rng_uniform->rng_int;
+
+   while (n > 0){
+      size_t nblock = (size_t) available_rng_int(rng_int);
+      if (nblock > n) {nblock = n;}
+
+      uniform_mtstate(rng_int->mtstate + rng_int->mtidx + 1, randnums, nblock,
+                      onebits, scale, offset);
+
+      rng_int->mtidx += (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next uniform random numbers in [lower,upper)
+//    with 52 random bits each
+// Variables:
+//    rng_uniform: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_uniform_closed_open(rng_uniform_type* rng_uniform, double* randnums, size_t n){
+   const double width = rng_uniform->upper - rng_uniform->lower;
+   // x in [1,2) to lower+(x-1)*width
+   fill_random_uniform_exponent(rng_uniform, randnums, n, EXPONENTONE,
+                                width, rng_uniform->lower - width);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next uniform random numbers in (lower,upper]
+//    with 52 random bits each
+// Variables:
+//    rng_uniform: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_uniform_open_closed(rng_uniform_type* rng_uniform, double* randnums, size_t n){
+   const double width = rng_uniform->upper - rng_uniform->lower;
+   // x in [1,2) to lower+(2-x)*width
+   fill_random_uniform_exponent(rng_uniform, randnums, n, EXPONENTONE,
+                                -width, rng_uniform->lower + 2.0*width);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next uniform random numbers in (lower,upper)
+//    with 52 random bits each, the lowest mantissa bit is always set
+// Variables:
+//    rng_uniform: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_uniform_open_open(rng_uniform_type* rng_uniform, double* randnums, size_t n){
+   const double width = rng_uniform->upper - rng_uniform->lower;
+   // x in (1,2) to lower+(x-1)*width
+   fill_random_uniform_exponent(rng_uniform, randnums, n, EXPONENTONE | 1ul,
+                                width, rng_uniform->lower - width);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next gaussian random numbers
+//    The numbers are identical to n consecutive calls of next_random_gaussian
+// Variables:
+//    rng_gaussian: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_gaussian(rng_gaussian_type* rng_gaussian, double* randnums, size_t n){
+   double u[GAUSS_BUFFERLENGTH];
+
+   if (n > 0 && rng_gaussian->generated) {
+      rng_gaussian->generated = false;
+      *randnums = rng_gaussian->z2 * rng_gaussian->stddev + rng_gaussian->mean;
+      randnums++;
+      n--;
+   }
+
+   // uniforms are only drawn in pairs, so a rejected pair simply
+   // gets replaced by the next pair of the following buffer fill
+   while (n > 0){
+      size_t npairs = (n+1)/2;
+      if (npairs > GAUSS_BUFFERLENGTH/2) {npairs = GAUSS_BUFFERLENGTH/2;}
+      fill_random_uniform(&rng_gaussian->rng_uniform, u, 2*npairs);
+
+      for (size_t i=0; i<npairs; i++){
+         if (u[2*i] <= __DBL_EPSILON__) {continue;}
+
+         box_muller_rng_gaussian(rng_gaussian, u[2*i], u[2*i+1]);
+         *randnums = rng_gaussian->z1 * rng_gaussian->stddev + rng_gaussian->mean;
+         randnums++;
+         n--;
+         if (n > 0) {
+            rng_gaussian->generated = false;
+            *randnums = rng_gaussian->z2 * rng_gaussian->stddev + rng_gaussian->mean;
+            randnums++;
+            n--;
+         }
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next gaussian random numbers
+//    The Box-Muller transform of next_random_gaussian is evaluated on
+//    whole blocks with vectorized polynomial approximations of log, sin
+//    and cos instead of libm. The same uniform numbers are used and the
+//    results agree with next_random_gaussian up to a few ulps.
+//    The results are identical on all cpus. The pending second number
+//    is shared with next_random_gaussian, so both can be mixed.
+// Variables:
+//    rng_gaussian: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_gaussian_simd(rng_gaussian_type* rng_gaussian, double* randnums, size_t n){
+   double u[GAUSS_BUFFERLENGTH];
+   double z[GAUSS_BUFFERLENGTH];
+
+   if (n > 0 && rng_gaussian->generated) {
+      rng_gaussian->generated = false;
+      *randnums = rng_gaussian->z2 * rng_gaussian->stddev + rng_gaussian->mean;
+      randnums++;
+      n--;
+   }
+
+   while (n > 0){
+      size_t npairs = (n+1)/2;
+      if (npairs > GAUSS_BUFFERLENGTH/2) {npairs = GAUSS_BUFFERLENGTH/2;}
+      fill_random_uniform(&rng_gaussian->rng_uniform, u, 2*npairs);
+      box_muller_pairs(u, z, npairs);
+
+      for (size_t i=0; i<npairs; i++){
+         if (u[2*i] <= __DBL_EPSILON__) {continue;}
+
+         rng_gaussian->z1 = z[2*i];
+         rng_gaussian->z2 = z[2*i+1];
+         rng_gaussian->generated = true;
+         *randnums = rng_gaussian->z1 * rng_gaussian->stddev + rng_gaussian->mean;
+         randnums++;
+         n--;
+         if (n > 0) {
+            rng_gaussian->generated = false;
+            *randnums = rng_gaussian->z2 * rng_gaussian->stddev + rng_gaussian->mean;
+            randnums++;
+            n--;
+         }
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next unbiased integer random numbers in
+//    [0,range). The raw numbers are generated in bulk into the array and
+//    mapped in place. A rejected number shifts the following ones by one
+//    position, the missing numbers at the end are generated again.
+// Variables:
+//    rng_int: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+//    range: number of possible values, has to be positive
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_range(rng_int_type* rng_int, uint64_t* randnums, size_t n, uint64_t range){
+   check_range(range);
+
+   if ((range & (range-1)) == 0){
+      fill_random_lint(rng_int, (long int*) randnums, n);
+      int shift = 64 - __builtin_ctzl(range);
+      for (size_t i=0; i<n; i++){
+         randnums[i] = range == 1 ? 0 : randnums[i] >> shift;
+      }
+      return;
+   }
+
+   uint64_t threshold = (0-range) % range;
+   size_t nmapped = 0;
+   while (nmapped < n){
+      fill_random_lint(rng_int, (long int*) randnums+nmapped, n-nmapped);
+      for (size_t i=nmapped; i<n; i++){
+         if (map_range(randnums[i], range, threshold, &randnums[nmapped])) {nmapped++;}
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next 32 bit int random numbers
+//    The numbers are identical to n consecutive calls of next_random_int32
+// Variables:
+//    rng_int32: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_int32(rng_int32_type* rng_int32, int* randnums, size_t n){
+   rng_int_type* rng_int = &rng_int32->rng_int;
+
+   if (n > 0 && rng_int32->buffered){
+      *randnums = next_random_int32(rng_int32);
+      randnums++;
+      n--;
+   }
+
+   while (n >= 2){
+      size_t nblock = (size_t) available_rng_int(rng_int);
+      if (nblock > n/2) {nblock = n/2;}
+
+      const long int* mtstate = rng_int->mtstate + rng_int->mtidx + 1;
+      for (size_t i=0; i<nblock; i++){
+         unsigned long int irng = temper_rng_int(mtstate[i]);
+         randnums[2*i] = (int) (irng>>32);
+         randnums[2*i+1] = (int) (unsigned int) irng;
+      }
+
+      rng_int->mtidx += (int) nblock;
+      randnums += 2*nblock;
+      n -= 2*nblock;
+   }
+
+   if (n > 0){
+      *randnums = next_random_int32(rng_int32);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next single precision uniform random numbers
+//    The numbers are identical to n consecutive calls of next_random_float
+// Variables:
+//    rng_float: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_float(rng_float_type* rng_float, float* randnums, size_t n){
+   rng_int32_type* rng_int32 = &rng_float->rng_int32;
+   rng_int_type* rng_int = &rng_int32->rng_int;
+   const float width = rng_float->upper - rng_float->lower;
+   const float lower = rng_float->lower;
+
+   if (n > 0 && rng_int32->buffered){
+      *randnums = next_random_float(rng_float);
+      randnums++;
+      n--;
+   }
+
+   while (n >= 2){
+      size_t nblock = (size_t) available_rng_int(rng_int);
+      if (nblock > n/2) {nblock = n/2;}
+
+      const long int* mtstate = rng_int->mtstate + rng_int->mtidx + 1;
+      for (size_t i=0; i<nblock; i++){
+         unsigned long int irng = temper_rng_int(mtstate[i]);
+         randnums[2*i] = float_rng_int32((unsigned int) (irng>>32)) * width + lower;
+         randnums[2*i+1] = float_rng_int32((unsigned int) irng) * width + lower;
+      }
+
+      rng_int->mtidx += (int) nblock;
+      randnums += 2*nblock;
+      n -= 2*nblock;
+   }
+
+   if (n > 0){
+      *randnums = next_random_float(rng_float);
+   }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Description:
 //    Save rng state to a string
@@ -298,6 +994,7 @@ rng_int_type restore_rng_state_int(char* intstate){
       sscanf(intstate, "%17lx", (unsigned long*) &rng_int.mtstate[i]);
       intstate += 17;
    } 
+   reset_instrument(&rng_int);
 
    return rng_int;
 }
@@ -15,12 +15,28 @@
    //       rng_gaussian_type rng_stateg
    //    For int and long int random numbers over the complete int/long int range
    //       rng_integer_type :: rng_statei
+   //    For int random numbers using both halves of every 64 bit number:
+   //       rng_int32_type rng_state32
+   //    For single precision uniform random numbers:
+   //       rng_float_type rng_statef
    //    Initialize the uniform random nuber state:
    //       rng_stateu = init_rng(seed, lowerbound, upperbound)
    //    Initialize the gaussian random nuber state:
    //       rng_stateg = init_rng_gaussian(seed, meanvalue, stddev)
    //    Initialize the int/long int random number state:
    //       rng_statei = init_rng_int(seed)
+   //    Initialize the 32 bit int random number state:
+   //       rng_state32 = init_rng_int32(seed)
+   //    Initialize the single precision uniform random number state:
+   //       rng_statef = init_rng_float(seed, lowerbound, upperbound)
+   //    Initialize a state in place without copying it, e.g.:
+   //       init_rng_uniform_inplace(&rng_stateu, seed, lowerbound, upperbound) ;
+   //       init_rng_int_inplace(&rng_statei, seed) ;
+   //    Initialize the int/long int random number state from 64 bit keys:
+   //       init_rng_int_by_array64(&rng_statei, keys, nkeys) ;
+   //    Reseed a state and keep its parameters:
+   //       reseed_rng_uniform(&rng_stateu, seed) ;
+   //       reseed_rng_gaussian_by_array64(&rng_stateg, keys, nkeys) ;
    //    Get the next random number:
    //       Uniform:
    //          random_number = next_random_uniform(&rng_rng_stateu) ;
@@ -30,6 +46,33 @@
    //          random_number = next_random_int(&rng_rng_statei) ;
    //       Long int:
    //          random_number = next_random_lint(&rng_rng_statei) ;
+   //       Unbiased integer in [0,range):
+   //          random_number = next_random_range(&rng_statei, range) ;
+   //       Int, both halves:
+   //          random_number = next_random_int32(&rng_state32) ;
+   //       Float:
+   //          random_number = next_random_float(&rng_statef) ;
+   //    Fill an array with the next n random numbers:
+   //       Uniform:
+   //          fill_random_uniform(&rng_stateu, random_numbers, n) ;
+   //       Uniform in [lower,upper), (lower,upper] or (lower,upper):
+   //          fill_random_uniform_closed_open(&rng_stateu, random_numbers, n) ;
+   //          fill_random_uniform_open_closed(&rng_stateu, random_numbers, n) ;
+   //          fill_random_uniform_open_open(&rng_stateu, random_numbers, n) ;
+   //       Gaussian:
+   //          fill_random_gaussian(&rng_stateg, random_numbers, n) ;
+   //       Gaussian, vectorized, identical up to a few ulps:
+   //          fill_random_gaussian_simd(&rng_stateg, random_numbers, n) ;
+   //       Int:
+   //          fill_random_int(&rng_statei, random_numbers, n) ;
+   //       Long int:
+   //          fill_random_lint(&rng_statei, random_numbers, n) ;
+   //       Unbiased integers in [0,range):
+   //          fill_random_range(&rng_statei, random_numbers, n, range) ;
+   //       Int, both halves:
+   //          fill_random_int32(&rng_state32, random_numbers, n) ;
+   //       Float:
+   //          fill_random_float(&rng_statef, random_numbers, n) ;
    //    Store the state in a string for writeout:
    //       Uniform:
    //          state_string = get_random_state_uniform(rng_stateu)
@@ -48,9 +91,35 @@
    ////////////////////////////////////////////////////////////////////////////////
 
    #include <stdbool.h>
+   #include <stddef.h>
+   #include <stdint.h>
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
 
    #define MTSTATESIZE 312
 
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the counters of an instrumented int random number
+   //    generator, see MT_random_instrument.h. Only part of the state if
+   //    the library is compiled with -DMT_RANDOM_INSTRUMENT.
+   // Variables:
+   //    ntwists: number of regenerations of the mersenne twister state
+   //    offset: position of the stream minus the numbers of all twists
+   //    twistcycles: cycles spent in the regenerations
+   //    ntransforms: number of Box-Muller transforms
+   //    transformcycles: cycles spent in the Box-Muller transforms
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_instrument_s {
+      uint64_t ntwists ;
+      uint64_t offset ;
+      uint64_t twistcycles ;
+      uint64_t ntransforms ;
+      uint64_t transformcycles ;
+   } rng_instrument_type ;
+
    /////////////////////////////////////////////////////////////////////////////
    // Description:
    //    Type to hold the state of an int random number generator
@@ -58,13 +127,30 @@
    //    seed: The seed
    //    mtstate: State of the mersenne twister
    //    mtidx: index of the current random number of current state
+   //    instrument: counters, only with -DMT_RANDOM_INSTRUMENT
    /////////////////////////////////////////////////////////////////////////////
    typedef struct rng_int_s {
       int seed ;
       int mtidx ;
       long int mtstate[MTSTATESIZE] ;
+   #ifdef MT_RANDOM_INSTRUMENT
+      rng_instrument_type instrument ;
+   #endif
    } rng_int_type ;
 
+   // -DMT_RANDOM_INSTRUMENT changes the layout of all states, so the
+   // library and the calling code have to agree on it. Every file that
+   // includes this header refers to the symbol of its own setting and the
+   // library only defines the symbol of the setting it was compiled with,
+   // a mismatch fails to link.
+   #ifdef MT_RANDOM_INSTRUMENT
+      #define MT_RANDOM_ABI mt_random_abi_instrumented
+   #else
+      #define MT_RANDOM_ABI mt_random_abi_plain
+   #endif
+   extern const int MT_RANDOM_ABI;
+   __attribute__((used)) static const int* const mt_random_abi_check = &MT_RANDOM_ABI;
+
    /////////////////////////////////////////////////////////////////////////////
    // Description:
    //    Type to hold the state of uniform random number generator
@@ -100,6 +186,37 @@
       rng_uniform_type rng_uniform ;
    } rng_gaussian_type;
 
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of an int random number generator that
+   //    returns both 32 bit halves of every 64 bit number, upper half first
+   // Variables:
+   //    buffered: Boolean if the lower half of the last number is unused
+   //    buffer: lower half of the last number
+   //    rng_int: int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_int32_s {
+      bool buffered ;
+      unsigned int buffer ;
+      rng_int_type rng_int ;
+   } rng_int32_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of a single precision uniform random number
+   //    generator. Every 32 bit half of a 64 bit number gives one float
+   //    with 24 random bits.
+   // Variables:
+   //    lower: lower bound of random numbers
+   //    upper: upper bound of random numbers
+   //    rng_int32: 32 bit int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_float_s {
+      float lower ;
+      float upper ;
+      rng_int32_type rng_int32 ;
+   } rng_float_type ;
+
    /////////////////////////////////////////////////////////////////////////////
    // Description:
    //    Initializes a int random number generator
@@ -134,6 +251,135 @@
    /////////////////////////////////////////////////////////////////////////////
    rng_gaussian_type init_rng_gaussian(int seed, double mean, double stddev);
 
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a 32 bit int random number generator
+   // Variables:
+   //    seed: The seed
+   // Return value:
+   //    rng_int32: 32 bit int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_int32_type init_rng_int32(int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a single precision uniform random number generator
+   // Variables:
+   //    seed: The seed
+   //    lower: lower bound of random numbers
+   //    upper: upper bound of random numbers
+   // Return value:
+   //    rng_float: single precision uniform random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_float_type init_rng_float(int seed, float lower, float upper);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a int random number generator in place
+   //    Can also be used to reseed an existing state.
+   // Variables:
+   //    rng_int: int random number state to initialize
+   //    seed: The seed
+   /////////////////////////////////////////////////////////////////////////////
+   void init_rng_int_inplace(rng_int_type* rng_int, int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a int random number generator in place from an array of
+   //    64 bit keys with the init_by_array64 scheme of the reference
+   //    MT19937-64 implementation. The seed member holds the lower 32 bits
+   //    of the first key.
+   // Variables:
+   //    rng_int: int random number state to initialize
+   //    key: array of keys
+   //    keylength: number of keys, has to be positive
+   /////////////////////////////////////////////////////////////////////////////
+   void init_rng_int_by_array64(rng_int_type* rng_int, const uint64_t* key, size_t keylength);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a uniform random number generator in place
+   // Variables:
+   //    rng_uniform: uniform random number state to initialize
+   //    seed: The seed
+   //    lower: lower bound of random numbers
+   //    upper: upper bound of random numbers
+   /////////////////////////////////////////////////////////////////////////////
+   void init_rng_uniform_inplace(rng_uniform_type* rng_uniform, int seed, double lower, double upper);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a gaussian random number generator in place
+   // Variables:
+   //    rng_gaussian: gaussian random number state to initialize
+   //    seed: The seed
+   //    mean: Mean value of the gaussian
+   //    stddev: standard deviation of the gaussian
+   /////////////////////////////////////////////////////////////////////////////
+   void init_rng_gaussian_inplace(rng_gaussian_type* rng_gaussian, int seed, double mean, double stddev);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a 32 bit int random number generator in place
+   // Variables:
+   //    rng_int32: 32 bit int random number state to initialize
+   //    seed: The seed
+   /////////////////////////////////////////////////////////////////////////////
+   void init_rng_int32_inplace(rng_int32_type* rng_int32, int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a single precision uniform random number generator in place
+   // Variables:
+   //    rng_float: single precision uniform random number state to initialize
+   //    seed: The seed
+   //    lower: lower bound of random numbers
+   //    upper: upper bound of random numbers
+   /////////////////////////////////////////////////////////////////////////////
+   void init_rng_float_inplace(rng_float_type* rng_float, int seed, float lower, float upper);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Reseeds a uniform random number generator, the bounds are kept
+   // Variables:
+   //    rng_uniform: uniform random number state
+   //    seed: The seed
+   /////////////////////////////////////////////////////////////////////////////
+   void reseed_rng_uniform(rng_uniform_type* rng_uniform, int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Reseeds a gaussian random number generator, mean value and standard
+   //    deviation are kept and a pending second Box-Muller number is dropped
+   // Variables:
+   //    rng_gaussian: gaussian random number state
+   //    seed: The seed
+   /////////////////////////////////////////////////////////////////////////////
+   void reseed_rng_gaussian(rng_gaussian_type* rng_gaussian, int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Reseeds a uniform random number generator from an array of 64 bit
+   //    keys, the bounds are kept
+   // Variables:
+   //    rng_uniform: uniform random number state
+   //    key: array of keys
+   //    keylength: number of keys, has to be positive
+   /////////////////////////////////////////////////////////////////////////////
+   void reseed_rng_uniform_by_array64(rng_uniform_type* rng_uniform, const uint64_t* key, size_t keylength);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Reseeds a gaussian random number generator from an array of 64 bit
+   //    keys, mean value and standard deviation are kept and a pending second
+   //    Box-Muller number is dropped
+   // Variables:
+   //    rng_gaussian: gaussian random number state
+   //    key: array of keys
+   //    keylength: number of keys, has to be positive
+   /////////////////////////////////////////////////////////////////////////////
+   void reseed_rng_gaussian_by_array64(rng_gaussian_type* rng_gaussian, const uint64_t* key, size_t keylength);
+
 
    /////////////////////////////////////////////////////////////////////////////
    // Description:
@@ -175,6 +421,173 @@
    /////////////////////////////////////////////////////////////////////////////
    double next_random_gaussian(rng_gaussian_type* rng_gaussian);
 
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next 32 bit int random number. The upper half of a
+   //    64 bit number is returned first, the lower half on the next call.
+   // Variables:
+   //    rng_int32: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   int next_random_int32(rng_int32_type* rng_int32);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next single precision uniform random number
+   // Variables:
+   //    rng_float: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   float next_random_float(rng_float_type* rng_float);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next unbiased integer random number in [0,range)
+   //    with a multiply-shift and rare rejection instead of a modulo.
+   //    Powers of two take the upper bits without rejection.
+   // Variables:
+   //    rng_int: Random number generator state
+   //    range: number of possible values, has to be positive
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   uint64_t next_random_range(rng_int_type* rng_int, uint64_t range);
+
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next long int random numbers
+   //    The numbers are identical to n consecutive calls of next_random_lint
+   // Variables:
+   //    rng_int: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_lint(rng_int_type* rng_int, long int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next int random numbers
+   //    The numbers are identical to n consecutive calls of next_random_int
+   // Variables:
+   //    rng_int: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_int(rng_int_type* rng_int, int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next uniform random numbers
+   //    The numbers are identical to n consecutive calls of next_random_uniform
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_uniform(rng_uniform_type* rng_uniform, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next uniform random numbers in [lower,upper)
+   //    with 52 random bits each. The numbers for [0,1) are exact multiples
+   //    of 2^-52, for other bounds the scaling can round onto a bound.
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_uniform_closed_open(rng_uniform_type* rng_uniform, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next uniform random numbers in (lower,upper]
+   //    with 52 random bits each. The numbers for (0,1] are never 0 and can
+   //    be passed to log without a check, for other bounds the scaling can
+   //    round onto a bound.
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_uniform_open_closed(rng_uniform_type* rng_uniform, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next uniform random numbers in (lower,upper)
+   //    with 52 random bits each, the lowest of them is always set. For
+   //    other bounds than (0,1) the scaling can round onto a bound.
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_uniform_open_open(rng_uniform_type* rng_uniform, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next gaussian random numbers
+   //    The numbers are identical to n consecutive calls of next_random_gaussian
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_gaussian(rng_gaussian_type* rng_gaussian, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next gaussian random numbers
+   //    The Box-Muller transform of next_random_gaussian is evaluated on
+   //    whole blocks with vectorized polynomial approximations of log, sin
+   //    and cos instead of libm. The same uniform numbers are used and the
+   //    results agree with next_random_gaussian up to a few ulps.
+   //    The results are identical on all cpus. The pending second number
+   //    is shared with next_random_gaussian, so both can be mixed.
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_gaussian_simd(rng_gaussian_type* rng_gaussian, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next unbiased integer random numbers in
+   //    [0,range). The numbers are identical to n consecutive calls of
+   //    next_random_range
+   // Variables:
+   //    rng_int: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   //    range: number of possible values, has to be positive
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_range(rng_int_type* rng_int, uint64_t* randnums, size_t n, uint64_t range);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next 32 bit int random numbers
+   //    The numbers are identical to n consecutive calls of next_random_int32
+   // Variables:
+   //    rng_int32: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_int32(rng_int32_type* rng_int32, int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next single precision uniform random numbers
+   //    The numbers are identical to n consecutive calls of next_random_float
+   // Variables:
+   //    rng_float: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_float(rng_float_type* rng_float, float* randnums, size_t n);
+
 
    /////////////////////////////////////////////////////////////////////////////
    // Description:
@@ -237,4 +650,8 @@
    /////////////////////////////////////////////////////////////////////////////
    rng_gaussian_type restore_rng_state_gaussian(char* rng_state);
 
+   #ifdef __cplusplus
+   }
+   #endif
+
 #endif
@@ -0,0 +1,239 @@
+#ifndef MT_RANDOM_HPP
+#define MT_RANDOM_HPP
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Header only C++ engines around the int, uniform and gaussian states.
+   //    The engines give the same numbers as the C routines on the same
+   //    state. The int engine is a UniformRandomBitGenerator and can be
+   //    passed to the <random> distributions and std::shuffle. The state
+   //    lives on the heap, so moving an engine only moves a pointer.
+   // Usage:
+   //    Import this header (link with MT_random.a):
+   //       #include "MT_random.hpp"
+   //    Create an engine:
+   //       mt_random::int_engine engine(seed) ;
+   //       mt_random::uniform_engine engineu(seed, lowerbound, upperbound) ;
+   //       mt_random::gaussian_engine engineg(seed, meanvalue, stddev) ;
+   //    Get the next random number:
+   //       random_number = engine() ;
+   //    Fill a range, arrays of result_type are filled in bulk:
+   //       engine.generate(first, last) ;
+   //    Skip the next n numbers:
+   //       engine.discard(n) ;
+   //    Use the C routines on the state:
+   //       state_string = get_random_state_int(&engine.state()) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <cstddef>
+   #include <cstdint>
+   #include <memory>
+   #include "MT_random.h"
+   #include "MT_random_inline.h"
+   #include "MT_random_jump.h"
+
+   namespace mt_random {
+
+      /////////////////////////////////////////////////////////////////////////////
+      // Description:
+      //    Maps an engine to the C routines of its state type
+      /////////////////////////////////////////////////////////////////////////////
+      template <typename State> struct engine_traits ;
+
+      template <> struct engine_traits<rng_int_type> {
+         typedef uint64_t result_type ;
+         static void init(rng_int_type* state, int seed){
+            init_rng_int_inplace(state, seed);
+         }
+         static void reseed(rng_int_type* state, int seed){
+            init_rng_int_inplace(state, seed);
+         }
+         static result_type next(rng_int_type* state){
+            return (result_type) next_random_lint_inline(state);
+         }
+         static void fill(rng_int_type* state, result_type* randnums, size_t n){
+            fill_random_lint(state, (long int*) randnums, n);
+         }
+         static void discard(rng_int_type* state, unsigned long long n){
+            rng_int_discard(state, n);
+         }
+         static constexpr result_type min(){return 0;}
+         static constexpr result_type max(){return UINT64_MAX;}
+      };
+
+      template <> struct engine_traits<rng_uniform_type> {
+         typedef double result_type ;
+         static void init(rng_uniform_type* state, int seed, double lower=0.0, double upper=1.0){
+            init_rng_uniform_inplace(state, seed, lower, upper);
+         }
+         static void reseed(rng_uniform_type* state, int seed){
+            reseed_rng_uniform(state, seed);
+         }
+         static result_type next(rng_uniform_type* state){
+            return next_random_uniform_inline(state);
+         }
+         static void fill(rng_uniform_type* state, result_type* randnums, size_t n){
+            fill_random_uniform(state, randnums, n);
+         }
+         static void discard(rng_uniform_type* state, unsigned long long n){
+            rng_uniform_discard(state, n);
+         }
+      };
+
+      template <> struct engine_traits<rng_gaussian_type> {
+         typedef double result_type ;
+         static void init(rng_gaussian_type* state, int seed, double mean=0.0, double stddev=1.0){
+            init_rng_gaussian_inplace(state, seed, mean, stddev);
+         }
+         static void reseed(rng_gaussian_type* state, int seed){
+            reseed_rng_gaussian(state, seed);
+         }
+         static result_type next(rng_gaussian_type* state){
+            return next_random_gaussian(state);
+         }
+         static void fill(rng_gaussian_type* state, result_type* randnums, size_t n){
+            fill_random_gaussian(state, randnums, n);
+         }
+         // rejected Box-Muller pairs make the number of uniform
+         // numbers per gaussian number unknown, so they are drawn
+         static void discard(rng_gaussian_type* state, unsigned long long n){
+            for (; n > 0; n--){
+               next_random_gaussian(state);
+            }
+         }
+      };
+
+      /////////////////////////////////////////////////////////////////////////////
+      // Description:
+      //    Engine owning a state of type State. A moved from engine has no
+      //    state and may only be assigned to or destroyed.
+      /////////////////////////////////////////////////////////////////////////////
+      template <typename State>
+      class basic_engine {
+         public:
+            typedef State state_type ;
+            typedef engine_traits<State> traits_type ;
+            typedef typename traits_type::result_type result_type ;
+
+            static const int default_seed = 5489 ;
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Creates an engine with a new state, params are the bounds of
+            //    the uniform or the mean and standard deviation of the
+            //    gaussian engine
+            // Variables:
+            //    seed: The seed
+            /////////////////////////////////////////////////////////////////////////////
+            template <typename... Params>
+            explicit basic_engine(int seed = default_seed, Params... params)
+               : state_(new State){
+               traits_type::init(state_.get(), seed, params...);
+            }
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Creates an engine that continues a copy of an existing state
+            // Variables:
+            //    state: state to copy
+            /////////////////////////////////////////////////////////////////////////////
+            explicit basic_engine(const State& state)
+               : state_(new State(state)){}
+
+            basic_engine(const basic_engine& other)
+               : state_(new State(*other.state_)){}
+
+            basic_engine(basic_engine&& other) noexcept = default ;
+
+            basic_engine& operator=(const basic_engine& other){
+               if (this != &other){
+                  state_.reset(new State(*other.state_));
+               }
+               return *this;
+            }
+
+            basic_engine& operator=(basic_engine&& other) noexcept = default ;
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Reseeds the state and keeps its parameters
+            // Variables:
+            //    seed: The seed
+            /////////////////////////////////////////////////////////////////////////////
+            void seed(int seed = default_seed){
+               traits_type::reseed(state_.get(), seed);
+            }
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Smallest and largest number of the int engine
+            /////////////////////////////////////////////////////////////////////////////
+            static constexpr result_type min(){return traits_type::min();}
+            static constexpr result_type max(){return traits_type::max();}
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Generates the next random number
+            // Return value:
+            //    randnum: next random number
+            /////////////////////////////////////////////////////////////////////////////
+            result_type operator()(){
+               return traits_type::next(state_.get());
+            }
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Fills an array with the next random numbers with the bulk
+            //    routine of the state
+            // Variables:
+            //    first: first element to fill
+            //    last: element behind the last element to fill
+            /////////////////////////////////////////////////////////////////////////////
+            void generate(result_type* first, result_type* last){
+               traits_type::fill(state_.get(), first, (size_t) (last - first));
+            }
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Assigns the next random numbers to a range of any iterator type
+            // Variables:
+            //    first: first element to assign to
+            //    last: element behind the last element to assign to
+            /////////////////////////////////////////////////////////////////////////////
+            template <typename Iterator>
+            void generate(Iterator first, Iterator last){
+               for (; first != last; ++first){
+                  *first = traits_type::next(state_.get());
+               }
+            }
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Skips the next n numbers, in O(log n) for the int and the
+            //    uniform engine
+            // Variables:
+            //    n: number of random numbers to skip
+            /////////////////////////////////////////////////////////////////////////////
+            void discard(unsigned long long n){
+               traits_type::discard(state_.get(), n);
+            }
+
+            /////////////////////////////////////////////////////////////////////////////
+            // Description:
+            //    Gives access to the state for the C routines
+            // Return value:
+            //    state: state of the engine
+            /////////////////////////////////////////////////////////////////////////////
+            State& state(){return *state_;}
+            const State& state() const {return *state_;}
+
+         private:
+            std::unique_ptr<State> state_ ;
+      };
+
+      typedef basic_engine<rng_int_type> int_engine ;
+      typedef basic_engine<rng_uniform_type> uniform_engine ;
+      typedef basic_engine<rng_gaussian_type> gaussian_engine ;
+
+   }
+
+#endif
@@ -0,0 +1,183 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "MT_random.h"
+#include "MT_random_alias.h"
+
+#define ALIAS_BUFFERLENGTH 256
+#define ALIAS_MAXOUTCOMES (1ul<<32)
+#define POW2_32 4294967296.0
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Packs the threshold and the alias of a bucket into a table entry
+// Variables:
+//    probability: probability to keep the own outcome of the bucket
+//    alias: outcome taken otherwise
+//    own: own outcome of the bucket
+// Return value:
+//    entry: packed bucket
+/////////////////////////////////////////////////////////////////////////////
+static uint64_t pack_alias_entry(double probability, size_t alias, size_t own){
+   // full buckets use themselves as alias, so the threshold does not matter
+   if (probability >= 1.0){
+      return (((uint64_t) 0xFFFFFFFF) << 32) | (uint64_t) own;
+   }
+   double threshold = floor(probability*POW2_32 + 0.5);
+   if (threshold > (double) 0xFFFFFFFF) {threshold = (double) 0xFFFFFFFF;}
+   return (((uint64_t) threshold) << 32) | (uint64_t) alias;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Maps a 64 bit random number to an outcome of an alias table
+// Variables:
+//    rng: 64 bit random number
+//    entries: buckets of the table
+//    n: number of outcomes
+// Return value:
+//    outcome: outcome in [0,n)
+/////////////////////////////////////////////////////////////////////////////
+static inline size_t map_alias(uint64_t rng, const uint64_t* entries, size_t n){
+   unsigned __int128 product = (unsigned __int128) rng * n;
+   size_t bucket = (size_t) (product >> 64);
+   uint32_t fraction = (uint32_t) ((uint64_t) product >> 32);
+   uint64_t entry = entries[bucket];
+   return fraction < (uint32_t) (entry >> 32) ? bucket : (size_t) (uint32_t) entry;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Builds an alias table from weights with the method of Vose.
+//    The weights are scaled to a mean of 1. Buckets below 1 are filled up
+//    by one of the buckets above 1, which becomes their alias and loses
+//    the amount. Both lists share one array, the small buckets grow from
+//    the front and the large ones from the back.
+// Variables:
+//    weights: non negative weights of the outcomes, not all zero
+//    n: number of outcomes, 1 to 2^32
+// Return value:
+//    alias_table: table that needs to be freed with free_alias_table
+/////////////////////////////////////////////////////////////////////////////
+alias_table_type init_alias_table(const double* weights, size_t n){
+   alias_table_type alias_table;
+
+   if (n == 0 || n > ALIAS_MAXOUTCOMES){
+      fprintf(stderr, "Error in initializing alias table with %zu outcomes.", n);
+      abort();
+   }
+
+   double sum = 0.0;
+   for (size_t i=0; i<n; i++){
+      if (!(weights[i] >= 0.0) || isinf(weights[i])){
+         fprintf(stderr, "Error in initializing alias table, invalid weight %zu.", i);
+         abort();
+      }
+      sum += weights[i];
+   }
+   if (!(sum > 0.0) || isinf(sum)){
+      fprintf(stderr, "Error in initializing alias table, invalid sum of weights.");
+      abort();
+   }
+
+   alias_table.n = n;
+   alias_table.entries = (uint64_t*) malloc(n*sizeof(uint64_t));
+   double* scaled = (double*) malloc(n*sizeof(double));
+   uint32_t* worklist = (uint32_t*) malloc(n*sizeof(uint32_t));
+   if (alias_table.entries == NULL || scaled == NULL || worklist == NULL){
+      fprintf(stderr, "Error in allocating alias table.");
+      abort();
+   }
+
+   const double scale = (double) n / sum;
+   size_t nsmall = 0;
+   size_t largebegin = n;
+   for (size_t i=0; i<n; i++){
+      scaled[i] = weights[i] * scale;
+      if (scaled[i] < 1.0){
+         worklist[nsmall++] = (uint32_t) i;
+      } else {
+         worklist[--largebegin] = (uint32_t) i;
+      }
+   }
+
+   while (nsmall > 0 && largebegin < n){
+      size_t small = worklist[--nsmall];
+      size_t large = worklist[largebegin];
+      alias_table.entries[small] = pack_alias_entry(scaled[small], large, small);
+      scaled[large] -= 1.0 - scaled[small];
+      if (scaled[large] < 1.0){
+         // the large bucket moves over to the small ones
+         largebegin++;
+         worklist[nsmall++] = (uint32_t) large;
+      }
+   }
+
+   // left over buckets are full up to rounding errors
+   while (nsmall > 0){
+      size_t small = worklist[--nsmall];
+      alias_table.entries[small] = pack_alias_entry(1.0, small, small);
+   }
+   while (largebegin < n){
+      size_t large = worklist[largebegin++];
+      alias_table.entries[large] = pack_alias_entry(1.0, large, large);
+   }
+
+   free(worklist);
+   free(scaled);
+   return alias_table;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Frees the memory of an alias table
+// Variables:
+//    alias_table: table to free
+/////////////////////////////////////////////////////////////////////////////
+void free_alias_table(alias_table_type* alias_table){
+   free(alias_table->entries);
+   alias_table->entries = NULL;
+   alias_table->n = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Draws the next outcome from an alias table
+// Variables:
+//    rng_int: Random number generator state
+//    alias_table: table of the distribution
+// Return value:
+//    outcome: next outcome in [0,n)
+/////////////////////////////////////////////////////////////////////////////
+size_t next_random_alias(rng_int_type* rng_int, const alias_table_type* alias_table){
+   uint64_t rng = (uint64_t) next_random_lint(rng_int);
+   return map_alias(rng, alias_table->entries, alias_table->n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next outcomes from an alias table.
+//    The outcomes are identical to n consecutive calls of
+//    next_random_alias
+// Variables:
+//    rng_int: Random number generator state
+//    alias_table: table of the distribution
+//    outcomes: array to hold the outcomes
+//    n: number of outcomes to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_alias(rng_int_type* rng_int, const alias_table_type* alias_table,
+                       size_t* outcomes, size_t n){
+   long int buffer[ALIAS_BUFFERLENGTH];
+   const uint64_t* entries = alias_table->entries;
+   const size_t noutcomes = alias_table->n;
+
+   while (n > 0){
+      size_t nblock = n < ALIAS_BUFFERLENGTH ? n : ALIAS_BUFFERLENGTH;
+      fill_random_lint(rng_int, buffer, nblock);
+      for (size_t i=0; i<nblock; i++){
+         outcomes[i] = map_alias((uint64_t) buffer[i], entries, noutcomes);
+      }
+      outcomes += nblock;
+      n -= nblock;
+   }
+}
@@ -0,0 +1,96 @@
+#ifndef MT_RANDOM_ALIAS_H
+#define MT_RANDOM_ALIAS_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to draw from discrete distributions with arbitrary
+   //    weights in constant time with the alias method (Walker 1977) and the
+   //    table construction of Vose (1991) in O(n).
+   //    Every outcome i owns a bucket that holds a threshold and an alias.
+   //    A single 64 bit random number selects the bucket with the upper half
+   //    of its product with n, the lower half is compared to the threshold
+   //    to choose between i and its alias. Threshold and alias are packed
+   //    into one 64 bit entry, so a draw touches a single table entry.
+   //    At most 2^32 outcomes are supported, the probabilities are resolved
+   //    to 2^-32.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_alias.h"
+   //    Build a table from n non negative weights (need not be normalized):
+   //       alias_table = init_alias_table(weights, n)
+   //    Draw outcomes in [0,n) with an int random number state:
+   //       outcome = next_random_alias(&rng_statei, &alias_table) ;
+   //       fill_random_alias(&rng_statei, &alias_table, outcomes, nsamples) ;
+   //    Free the table:
+   //       free_alias_table(&alias_table) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include <stdint.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold an alias table
+   // Variables:
+   //    n: number of outcomes
+   //    entries: bucket i holds the threshold in the upper and the alias
+   //             in the lower 32 bits
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct alias_table_s {
+      size_t n ;
+      uint64_t* entries ;
+   } alias_table_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Builds an alias table from weights
+   // Variables:
+   //    weights: non negative weights of the outcomes, not all zero
+   //    n: number of outcomes, 1 to 2^32
+   // Return value:
+   //    alias_table: table that needs to be freed with free_alias_table
+   /////////////////////////////////////////////////////////////////////////////
+   alias_table_type init_alias_table(const double* weights, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Frees the memory of an alias table
+   // Variables:
+   //    alias_table: table to free
+   /////////////////////////////////////////////////////////////////////////////
+   void free_alias_table(alias_table_type* alias_table);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Draws the next outcome from an alias table
+   // Variables:
+   //    rng_int: Random number generator state
+   //    alias_table: table of the distribution
+   // Return value:
+   //    outcome: next outcome in [0,n)
+   /////////////////////////////////////////////////////////////////////////////
+   size_t next_random_alias(rng_int_type* rng_int, const alias_table_type* alias_table);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next outcomes from an alias table.
+   //    The outcomes are identical to n consecutive calls of
+   //    next_random_alias
+   // Variables:
+   //    rng_int: Random number generator state
+   //    alias_table: table of the distribution
+   //    outcomes: array to hold the outcomes
+   //    n: number of outcomes to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_alias(rng_int_type* rng_int, const alias_table_type* alias_table,
+                          size_t* outcomes, size_t n);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
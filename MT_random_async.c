@@ -0,0 +1,295 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <sched.h>
+#include <time.h>
+#include <pthread.h>
+#include "MT_random.h"
+#include "MT_random_async.h"
+
+#define ASYNC_MINCAPACITY 64
+#define ASYNC_MAXCHUNK 4096
+// the producer sleeps if the ring stays full for this many checks
+#define ASYNC_MAXYIELDS 64
+#define ASYNC_SLEEPNS 20000
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills the next chunk of the ring with the state of the producer
+// Variables:
+//    async: ring
+//    pos: position of the chunk
+/////////////////////////////////////////////////////////////////////////////
+static void produce_chunk(rng_async_type* async, size_t pos){
+   size_t index = pos & async->mask;
+   switch (async->type){
+      case 'I':
+         fill_random_lint(&async->rng.rng_int, (long int*) async->buffer + index, async->chunk);
+         break;
+      case 'U':
+         fill_random_uniform(&async->rng.rng_uniform, (double*) async->buffer + index, async->chunk);
+         break;
+      default:
+         fill_random_gaussian(&async->rng.rng_gaussian, (double*) async->buffer + index, async->chunk);
+         break;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Producer thread. Adds a chunk whenever the consumer has released
+//    enough space. Otherwise it yields the processor and, if the consumer
+//    stays away, sleeps so an idle ring does not occupy a core.
+// Variables:
+//    arg: ring
+/////////////////////////////////////////////////////////////////////////////
+static void* rng_async_producer(void* arg){
+   rng_async_type* async = (rng_async_type*) arg;
+   const size_t capacity = async->mask + 1;
+   const struct timespec sleeptime = {0, ASYNC_SLEEPNS};
+   int nyields = 0;
+
+   while (!__atomic_load_n(&async->stop, __ATOMIC_ACQUIRE)){
+      if (capacity - (async->writepos - async->cachedtail) < async->chunk){
+         async->cachedtail = __atomic_load_n(&async->tail, __ATOMIC_ACQUIRE);
+         if (capacity - (async->writepos - async->cachedtail) < async->chunk){
+            if (nyields < ASYNC_MAXYIELDS){
+               nyields++;
+               sched_yield();
+            } else {
+               nanosleep(&sleeptime, NULL);
+            }
+            continue;
+         }
+      }
+      nyields = 0;
+      produce_chunk(async, async->writepos);
+      async->writepos += async->chunk;
+      __atomic_store_n(&async->head, async->writepos, __ATOMIC_RELEASE);
+   }
+   return NULL;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Allocates a ring and starts the producer thread on it
+// Variables:
+//    type: type tag of the numbers
+//    capacity: minimum number of values in the ring
+//    valuesize: size of a value in bytes
+// Return value:
+//    async: ring with the producer state still to be set
+/////////////////////////////////////////////////////////////////////////////
+static rng_async_type* alloc_rng_async(char type, size_t capacity, size_t valuesize){
+   if (capacity > SIZE_MAX/2/valuesize){
+      fprintf(stderr, "Error in creating random number ring of %zu values.", capacity);
+      abort();
+   }
+   size_t realcapacity = ASYNC_MINCAPACITY;
+   while (realcapacity < capacity) {realcapacity *= 2;}
+
+   void* async = NULL;
+   void* buffer = NULL;
+   if (posix_memalign(&async, RNG_ASYNC_CACHELINESIZE, sizeof(rng_async_type)) != 0 ||
+       posix_memalign(&buffer, RNG_ASYNC_CACHELINESIZE, realcapacity*valuesize) != 0){
+      fprintf(stderr, "Error in allocating random number ring.");
+      abort();
+   }
+
+   rng_async_type* ring = (rng_async_type*) async;
+   ring->buffer = buffer;
+   ring->mask = realcapacity - 1;
+   ring->chunk = realcapacity/4 < ASYNC_MAXCHUNK ? realcapacity/4 : ASYNC_MAXCHUNK;
+   ring->type = type;
+   ring->head = 0;
+   ring->tail = 0;
+   ring->readpos = 0;
+   ring->cachedhead = 0;
+   ring->writepos = 0;
+   ring->cachedtail = 0;
+   ring->stop = false;
+   return ring;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Starts the producer thread of a ring
+// Variables:
+//    async: ring with the producer state set
+// Return value:
+//    async: ring
+/////////////////////////////////////////////////////////////////////////////
+static rng_async_type* start_rng_async(rng_async_type* async){
+   if (pthread_create(&async->thread, NULL, rng_async_producer, async) != 0){
+      fprintf(stderr, "Error in creating random number producer thread.");
+      abort();
+   }
+   return async;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Starts a producer thread on a copy of an int state
+// Variables:
+//    rng_int: Random number generator state, it is not advanced
+//    capacity: minimum number of values in the ring
+// Return value:
+//    async: ring that needs to be freed with free_rng_async
+/////////////////////////////////////////////////////////////////////////////
+rng_async_type* create_rng_async_int(const rng_int_type* rng_int, size_t capacity){
+   rng_async_type* async = alloc_rng_async('I', capacity, sizeof(long int));
+   async->rng.rng_int = *rng_int;
+   return start_rng_async(async);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Starts a producer thread on a copy of a uniform state
+// Variables:
+//    rng_uniform: Random number generator state, it is not advanced
+//    capacity: minimum number of values in the ring
+// Return value:
+//    async: ring that needs to be freed with free_rng_async
+/////////////////////////////////////////////////////////////////////////////
+rng_async_type* create_rng_async_uniform(const rng_uniform_type* rng_uniform, size_t capacity){
+   rng_async_type* async = alloc_rng_async('U', capacity, sizeof(double));
+   async->rng.rng_uniform = *rng_uniform;
+   return start_rng_async(async);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Starts a producer thread on a copy of a gaussian state
+// Variables:
+//    rng_gaussian: Random number generator state, it is not advanced
+//    capacity: minimum number of values in the ring
+// Return value:
+//    async: ring that needs to be freed with free_rng_async
+/////////////////////////////////////////////////////////////////////////////
+rng_async_type* create_rng_async_gaussian(const rng_gaussian_type* rng_gaussian, size_t capacity){
+   rng_async_type* async = alloc_rng_async('G', capacity, sizeof(double));
+   async->rng.rng_gaussian = *rng_gaussian;
+   return start_rng_async(async);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Stops the producer thread and frees the ring
+// Variables:
+//    async: ring to free
+/////////////////////////////////////////////////////////////////////////////
+void free_rng_async(rng_async_type* async){
+   __atomic_store_n(&async->stop, true, __ATOMIC_RELEASE);
+   pthread_join(async->thread, NULL);
+   free(async->buffer);
+   free(async);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Waits until the ring holds a number for the consumer. Called by the
+//    consumer routines if no produced number is known, checks the type.
+// Variables:
+//    async: ring
+//    type: type tag the consumer expects
+/////////////////////////////////////////////////////////////////////////////
+void wait_rng_async(rng_async_type* async, char type){
+   if (async->type != type){
+      fprintf(stderr, "Error in taking '%c' numbers from a '%c' random number ring.", type, async->type);
+      abort();
+   }
+
+   // hand the released numbers over before waiting for new ones
+   __atomic_store_n(&async->tail, async->readpos, __ATOMIC_RELEASE);
+   async->cachedhead = __atomic_load_n(&async->head, __ATOMIC_ACQUIRE);
+   while (async->readpos == async->cachedhead){
+      sched_yield();
+      async->cachedhead = __atomic_load_n(&async->head, __ATOMIC_ACQUIRE);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Releases consumed numbers to the producer
+// Variables:
+//    async: ring
+//    n: number of values to release, at most the acquired ones
+/////////////////////////////////////////////////////////////////////////////
+void release_random_async(rng_async_type* async, size_t n){
+   if (n > async->cachedhead - async->readpos){
+      fprintf(stderr, "Error in releasing more random numbers than acquired.");
+      abort();
+   }
+   async->readpos += n;
+   __atomic_store_n(&async->tail, async->readpos, __ATOMIC_RELEASE);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Waits for numbers and returns how many are contiguous in the ring
+// Variables:
+//    async: ring
+//    type: type tag the consumer expects
+// Return value:
+//    n: number of available values, at least 1
+/////////////////////////////////////////////////////////////////////////////
+static size_t acquire_random_async(rng_async_type* async, char type){
+   if (async->readpos == async->cachedhead || async->type != type){
+      wait_rng_async(async, type);
+   }
+   size_t available = async->cachedhead - async->readpos;
+   size_t untilend = async->mask + 1 - (async->readpos & async->mask);
+   return available < untilend ? available : untilend;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Waits for numbers of an int ring and hands out all that are
+//    contiguous in the ring. They stay valid until they are released with
+//    release_random_async.
+// Variables:
+//    async: ring of int numbers
+//    randnums: set to the first number
+// Return value:
+//    n: number of available values, at least 1
+/////////////////////////////////////////////////////////////////////////////
+size_t acquire_random_lint_async(rng_async_type* async, const long int** randnums){
+   size_t n = acquire_random_async(async, 'I');
+   *randnums = (const long int*) async->buffer + (async->readpos & async->mask);
+   return n;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Waits for numbers of a uniform ring and hands out all that are
+//    contiguous in the ring. They stay valid until they are released with
+//    release_random_async.
+// Variables:
+//    async: ring of uniform numbers
+//    randnums: set to the first number
+// Return value:
+//    n: number of available values, at least 1
+/////////////////////////////////////////////////////////////////////////////
+size_t acquire_random_uniform_async(rng_async_type* async, const double** randnums){
+   size_t n = acquire_random_async(async, 'U');
+   *randnums = (const double*) async->buffer + (async->readpos & async->mask);
+   return n;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Waits for numbers of a gaussian ring and hands out all that are
+//    contiguous in the ring. They stay valid until they are released with
+//    release_random_async.
+// Variables:
+//    async: ring of gaussian numbers
+//    randnums: set to the first number
+// Return value:
+//    n: number of available values, at least 1
+/////////////////////////////////////////////////////////////////////////////
+size_t acquire_random_gaussian_async(rng_async_type* async, const double** randnums){
+   size_t n = acquire_random_async(async, 'G');
+   *randnums = (const double*) async->buffer + (async->readpos & async->mask);
+   return n;
+}
@@ -0,0 +1,256 @@
+#ifndef MT_RANDOM_ASYNC_H
+#define MT_RANDOM_ASYNC_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to generate random numbers in a background thread.
+   //    A producer thread fills a ring buffer in chunks with the bulk fill
+   //    routines of MT_random.h, a single consumer thread takes the numbers.
+   //    Taking a number is a load and an index increment as long as the ring
+   //    is not empty, the twist and the Box-Muller transform run on the
+   //    producer thread. The ring is lock free, producer and consumer only
+   //    share the two positions, each in its own cache line.
+   //    The consumer receives exactly the sequence the state would produce.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_async.h"
+   //    Start a producer on a copy of a state with a ring of at least
+   //    capacity numbers (link with -pthread):
+   //       async = create_rng_async_int(&rng_statei, capacity) ;
+   //       async = create_rng_async_uniform(&rng_stateu, capacity) ;
+   //       async = create_rng_async_gaussian(&rng_stateg, capacity) ;
+   //    Get the next random number from a ring of the matching type:
+   //       random_number = next_random_lint_async(async) ;
+   //       random_number = next_random_uniform_async(async) ;
+   //       random_number = next_random_gaussian_async(async) ;
+   //    Take a batch of numbers in place and release them after use:
+   //       n = acquire_random_uniform_async(async, &random_numbers) ;
+   //       ...use random_numbers[0] to random_numbers[n-1]...
+   //       release_random_async(async, n) ;
+   //       (acquire_random_lint_async and acquire_random_gaussian_async for
+   //        the other types)
+   //    Stop the producer and free the ring:
+   //       free_rng_async(async) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stdbool.h>
+   #include <stddef.h>
+   #include <pthread.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   #define RNG_ASYNC_CACHELINESIZE 64
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold a ring buffer with its producer. The members are grouped
+   //    by the thread that writes them. Only to be used through the routines.
+   // Variables:
+   //    buffer: ring of numbers
+   //    mask: capacity-1, the capacity is a power of two
+   //    chunk: number of values the producer adds at once
+   //    type: type tag 'I', 'U' or 'G' of the numbers
+   //    thread: producer thread
+   //    head: position behind the last produced number, set by the producer
+   //    tail: position of the first unreleased number, set by the consumer
+   //          before it reads the first number of a chunk
+   //    readpos: position of the next number of the consumer
+   //    cachedhead: last head the consumer has seen
+   //    writepos: position of the next number of the producer
+   //    cachedtail: last tail the producer has seen
+   //    stop: Boolean if the producer has to stop
+   //    rng_*: state of the producer
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_async_s {
+      void* buffer ;
+      size_t mask ;
+      size_t chunk ;
+      char type ;
+      pthread_t thread ;
+      char pad0[RNG_ASYNC_CACHELINESIZE] ;
+      size_t head ;
+      char pad1[RNG_ASYNC_CACHELINESIZE] ;
+      size_t tail ;
+      char pad2[RNG_ASYNC_CACHELINESIZE] ;
+      size_t readpos ;
+      size_t cachedhead ;
+      char pad3[RNG_ASYNC_CACHELINESIZE] ;
+      size_t writepos ;
+      size_t cachedtail ;
+      bool stop ;
+      union {
+         rng_int_type rng_int ;
+         rng_uniform_type rng_uniform ;
+         rng_gaussian_type rng_gaussian ;
+      } rng ;
+   } rng_async_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Starts a producer thread on a copy of an int state
+   // Variables:
+   //    rng_int: Random number generator state, it is not advanced
+   //    capacity: minimum number of values in the ring
+   // Return value:
+   //    async: ring that needs to be freed with free_rng_async
+   /////////////////////////////////////////////////////////////////////////////
+   rng_async_type* create_rng_async_int(const rng_int_type* rng_int, size_t capacity);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Starts a producer thread on a copy of a uniform state
+   // Variables:
+   //    rng_uniform: Random number generator state, it is not advanced
+   //    capacity: minimum number of values in the ring
+   // Return value:
+   //    async: ring that needs to be freed with free_rng_async
+   /////////////////////////////////////////////////////////////////////////////
+   rng_async_type* create_rng_async_uniform(const rng_uniform_type* rng_uniform, size_t capacity);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Starts a producer thread on a copy of a gaussian state
+   // Variables:
+   //    rng_gaussian: Random number generator state, it is not advanced
+   //    capacity: minimum number of values in the ring
+   // Return value:
+   //    async: ring that needs to be freed with free_rng_async
+   /////////////////////////////////////////////////////////////////////////////
+   rng_async_type* create_rng_async_gaussian(const rng_gaussian_type* rng_gaussian, size_t capacity);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Stops the producer thread and frees the ring
+   // Variables:
+   //    async: ring to free
+   /////////////////////////////////////////////////////////////////////////////
+   void free_rng_async(rng_async_type* async);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Waits until the ring holds a number for the consumer. Called by the
+   //    consumer routines if no produced number is known or the type does
+   //    not match, aborts for a wrong type.
+   // Variables:
+   //    async: ring
+   //    type: type tag the consumer expects
+   /////////////////////////////////////////////////////////////////////////////
+   void wait_rng_async(rng_async_type* async, char type);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Releases consumed numbers to the producer
+   // Variables:
+   //    async: ring
+   //    n: number of values to release, at most the acquired ones
+   /////////////////////////////////////////////////////////////////////////////
+   void release_random_async(rng_async_type* async, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Takes the next value of the ring for the consumer
+   // Variables:
+   //    async: ring
+   //    type: type tag the consumer expects
+   // Return value:
+   //    index: position of the value in the buffer
+   /////////////////////////////////////////////////////////////////////////////
+   static inline size_t next_index_async(rng_async_type* async, char type){
+      // the numbers before readpos have been read by the caller, only
+      // those may be overwritten by the producer
+      if ((async->readpos & (async->chunk-1)) == 0){
+         __atomic_store_n(&async->tail, async->readpos, __ATOMIC_RELEASE);
+      }
+      if (async->readpos == async->cachedhead || __builtin_expect(async->type != type, 0)){
+         wait_rng_async(async, type);
+      }
+      size_t index = async->readpos & async->mask;
+      async->readpos++;
+      return index;
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next long int random number from an int ring
+   // Variables:
+   //    async: ring
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   static inline long int next_random_lint_async(rng_async_type* async){
+      size_t index = next_index_async(async, 'I');
+      return ((const long int*) async->buffer)[index];
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next uniform random number from a uniform ring
+   // Variables:
+   //    async: ring
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   static inline double next_random_uniform_async(rng_async_type* async){
+      size_t index = next_index_async(async, 'U');
+      return ((const double*) async->buffer)[index];
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next gaussian random number from a gaussian ring
+   // Variables:
+   //    async: ring
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   static inline double next_random_gaussian_async(rng_async_type* async){
+      size_t index = next_index_async(async, 'G');
+      return ((const double*) async->buffer)[index];
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Waits for numbers of an int ring and hands out all that are
+   //    contiguous in the ring. They stay valid until they are released with
+   //    release_random_async.
+   // Variables:
+   //    async: ring of int numbers
+   //    randnums: set to the first number
+   // Return value:
+   //    n: number of available values, at least 1
+   /////////////////////////////////////////////////////////////////////////////
+   size_t acquire_random_lint_async(rng_async_type* async, const long int** randnums);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Waits for numbers of a uniform ring and hands out all that are
+   //    contiguous in the ring. They stay valid until they are released with
+   //    release_random_async.
+   // Variables:
+   //    async: ring of uniform numbers
+   //    randnums: set to the first number
+   // Return value:
+   //    n: number of available values, at least 1
+   /////////////////////////////////////////////////////////////////////////////
+   size_t acquire_random_uniform_async(rng_async_type* async, const double** randnums);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Waits for numbers of a gaussian ring and hands out all that are
+   //    contiguous in the ring. They stay valid until they are released with
+   //    release_random_async.
+   // Variables:
+   //    async: ring of gaussian numbers
+   //    randnums: set to the first number
+   // Return value:
+   //    n: number of available values, at least 1
+   /////////////////////////////////////////////////////////////////////////////
+   size_t acquire_random_gaussian_async(rng_async_type* async, const double** randnums);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
@@ -0,0 +1,1056 @@
+////////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Benchmark of the random number routines. Every case is run with
+//    several batch sizes (numbers per call) and thread counts. Each thread
+//    works on its own state. After warmup runs the number of calls per run
+//    is calibrated to a minimum run time, and the repeated runs are
+//    reported as median and percentiles of the time per value together
+//    with the throughput of all threads.
+//    For comparison glibc random_r, C++ std::mt19937_64 and a binary
+//    search in a cumulative distribution are measured.
+//    With -latency the duration of single calls is measured instead and
+//    reported as distribution, which shows the cost of the state
+//    regeneration hidden in the averages.
+//    Before any measurement the generators are compared with the published
+//    outputs of the reference implementations.
+// Usage:
+//    ./MT_random_bench [options]
+//       -csv            machine readable output
+//       -reps n         number of timed runs (default 15)
+//       -warmup n       number of untimed runs (default 3)
+//       -mintime s      minimum duration of a run in seconds (default 1e-3)
+//       -threads list   comma separated thread counts (default 1,2,4)
+//       -batches list   comma separated batch sizes (default 1,64,4096,262144)
+//       -filter text    only run cases whose name contains text
+//       -latency        measure the latency distribution of single calls
+//       -samples n      number of timed calls per latency case (default 1000000)
+////////////////////////////////////////////////////////////////////////////////
+
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "MT_random.h"
+#include "MT_random_serialize.h"
+#include "MT_random_incremental.h"
+#include "MT_random_distributions.h"
+#include "MT_random_alias.h"
+#include "MT_random_shuffle.h"
+#include "MT_random_async.h"
+#include "MT_random_inline.h"
+#include "MT_random_engines.h"
+
+#define MAXLISTLENGTH 16
+#define RANDOMRSTATELENGTH 128
+// range for bounded integers, not a power of two
+#define BENCHRANGE 1000000007ul
+// number of outcomes of the discrete distribution
+#define BENCHOUTCOMES (1ul<<20)
+
+// C++ engines (MT_random_bench_std.cpp)
+void* bench_std_mt19937_64_create(unsigned long int seed);
+void bench_std_mt19937_64_destroy(void* engine);
+void bench_std_mt19937_64_fill(void* engine, unsigned long int* randnums, size_t n);
+void* bench_int_engine_create(int seed);
+void bench_int_engine_destroy(void* engine);
+void bench_int_engine_fill(void* engine, unsigned long int* randnums, size_t n);
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Everything a single benchmark thread works on
+// Variables:
+//    rng_int, rng_uniform, rng_gaussian, rng_int32, rng_float,
+//       rng_int_incremental, rng_exponential, rng_gamma, rng_poisson,
+//       rng_binomial, rng_mt32, rng_sfmt, rng_dsfmt: random number states
+//    random_data, random_statebuf: glibc random_r state
+//    std_mt, int_engine: C++ engines
+//    async_gaussian: ring filled by a producer thread
+//    alias_table, cdf: discrete distribution as alias table and as
+//       cumulative distribution
+//    randnums: output buffer for the largest batch
+//    intstate, uniformstate, gaussianstate: stored states for restoring
+//    serialstate: binary stored state for restoring
+//    sink: accumulates results that are otherwise unused
+/////////////////////////////////////////////////////////////////////////////
+typedef struct bench_state_s {
+   rng_int_type rng_int ;
+   rng_uniform_type rng_uniform ;
+   rng_gaussian_type rng_gaussian ;
+   rng_int32_type rng_int32 ;
+   rng_float_type rng_float ;
+   rng_mt32_type rng_mt32 ;
+   rng_sfmt_type rng_sfmt ;
+   rng_dsfmt_type rng_dsfmt ;
+   rng_int_incremental_type rng_int_incremental ;
+   rng_exponential_type rng_exponential ;
+   rng_gamma_type rng_gamma ;
+   rng_poisson_type rng_poisson ;
+   rng_binomial_type rng_binomial ;
+   struct random_data random_data ;
+   char random_statebuf[RANDOMRSTATELENGTH] ;
+   void* std_mt ;
+   void* int_engine ;
+   rng_async_type* async_gaussian ;
+   alias_table_type alias_table ;
+   double* cdf ;
+   void* randnums ;
+   char* intstate ;
+   char* uniformstate ;
+   char* gaussianstate ;
+   unsigned char serialstate[RNG_GAUSSIAN_SERIALSIZE] ;
+   unsigned long int sink ;
+} bench_state_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    A benchmark case
+// Variables:
+//    name: name of the case
+//    valuebytes: bytes produced or processed per value
+//    maxbatch: largest sensible batch size
+//    run: performs batch operations on a state
+/////////////////////////////////////////////////////////////////////////////
+typedef struct bench_case_s {
+   const char* name ;
+   size_t valuebytes ;
+   size_t maxbatch ;
+   void (*run)(bench_state_type* state, size_t batch) ;
+} bench_case_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    The benchmarked operations
+// Variables:
+//    state: state of the thread
+//    batch: number of values
+/////////////////////////////////////////////////////////////////////////////
+static void run_next_random_int(bench_state_type* state, size_t batch){
+   int* randnums = (int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_int(&state->rng_int);
+   }
+}
+
+static void run_next_random_lint(bench_state_type* state, size_t batch){
+   long int* randnums = (long int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_lint(&state->rng_int);
+   }
+}
+
+static void run_next_random_uniform(bench_state_type* state, size_t batch){
+   double* randnums = (double*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_uniform(&state->rng_uniform);
+   }
+}
+
+static void run_next_random_lint_inline(bench_state_type* state, size_t batch){
+   long int* randnums = (long int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_lint_inline(&state->rng_int);
+   }
+}
+
+static void run_next_random_uniform_inline(bench_state_type* state, size_t batch){
+   double* randnums = (double*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_uniform_inline(&state->rng_uniform);
+   }
+}
+
+static void run_next_random_gaussian(bench_state_type* state, size_t batch){
+   double* randnums = (double*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_gaussian(&state->rng_gaussian);
+   }
+}
+
+static void run_next_random_range(bench_state_type* state, size_t batch){
+   uint64_t* randnums = (uint64_t*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_range(&state->rng_int, BENCHRANGE);
+   }
+}
+
+static void run_next_random_int32(bench_state_type* state, size_t batch){
+   int* randnums = (int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_int32(&state->rng_int32);
+   }
+}
+
+static void run_next_random_int_mt32(bench_state_type* state, size_t batch){
+   int* randnums = (int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_int_mt32(&state->rng_mt32);
+   }
+}
+
+static void run_next_random_lint_sfmt(bench_state_type* state, size_t batch){
+   long int* randnums = (long int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_lint_sfmt(&state->rng_sfmt);
+   }
+}
+
+static void run_next_random_uniform_dsfmt(bench_state_type* state, size_t batch){
+   double* randnums = (double*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_uniform_dsfmt(&state->rng_dsfmt);
+   }
+}
+
+static void run_next_random_float(bench_state_type* state, size_t batch){
+   float* randnums = (float*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_float(&state->rng_float);
+   }
+}
+
+static void run_next_random_lint_incremental(bench_state_type* state, size_t batch){
+   long int* randnums = (long int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_lint_incremental(&state->rng_int_incremental);
+   }
+}
+
+static void run_next_random_exponential(bench_state_type* state, size_t batch){
+   double* randnums = (double*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_exponential(&state->rng_exponential);
+   }
+}
+
+static void run_next_random_gaussian_async(bench_state_type* state, size_t batch){
+   double* randnums = (double*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_gaussian_async(state->async_gaussian);
+   }
+}
+
+static void run_fill_random_uniform_closed_open(bench_state_type* state, size_t batch){
+   fill_random_uniform_closed_open(&state->rng_uniform, (double*) state->randnums, batch);
+}
+
+static void run_fill_random_int(bench_state_type* state, size_t batch){
+   fill_random_int(&state->rng_int, (int*) state->randnums, batch);
+}
+
+static void run_fill_random_lint(bench_state_type* state, size_t batch){
+   fill_random_lint(&state->rng_int, (long int*) state->randnums, batch);
+}
+
+static void run_fill_random_uniform(bench_state_type* state, size_t batch){
+   fill_random_uniform(&state->rng_uniform, (double*) state->randnums, batch);
+}
+
+static void run_fill_random_gaussian(bench_state_type* state, size_t batch){
+   fill_random_gaussian(&state->rng_gaussian, (double*) state->randnums, batch);
+}
+
+static void run_fill_random_gaussian_simd(bench_state_type* state, size_t batch){
+   fill_random_gaussian_simd(&state->rng_gaussian, (double*) state->randnums, batch);
+}
+
+static void run_fill_random_range(bench_state_type* state, size_t batch){
+   fill_random_range(&state->rng_int, (uint64_t*) state->randnums, batch, BENCHRANGE);
+}
+
+static void run_fill_random_int32(bench_state_type* state, size_t batch){
+   fill_random_int32(&state->rng_int32, (int*) state->randnums, batch);
+}
+
+static void run_fill_random_int_mt32(bench_state_type* state, size_t batch){
+   fill_random_int_mt32(&state->rng_mt32, (int*) state->randnums, batch);
+}
+
+static void run_fill_random_int_sfmt(bench_state_type* state, size_t batch){
+   fill_random_int_sfmt(&state->rng_sfmt, (int*) state->randnums, batch);
+}
+
+static void run_fill_random_lint_sfmt(bench_state_type* state, size_t batch){
+   fill_random_lint_sfmt(&state->rng_sfmt, (long int*) state->randnums, batch);
+}
+
+static void run_fill_random_uniform_dsfmt(bench_state_type* state, size_t batch){
+   fill_random_uniform_dsfmt(&state->rng_dsfmt, (double*) state->randnums, batch);
+}
+
+static void run_fill_random_float(bench_state_type* state, size_t batch){
+   fill_random_float(&state->rng_float, (float*) state->randnums, batch);
+}
+
+static void run_fill_random_exponential(bench_state_type* state, size_t batch){
+   fill_random_exponential(&state->rng_exponential, (double*) state->randnums, batch);
+}
+
+static void run_fill_random_gamma(bench_state_type* state, size_t batch){
+   fill_random_gamma(&state->rng_gamma, (double*) state->randnums, batch);
+}
+
+static void run_fill_random_poisson(bench_state_type* state, size_t batch){
+   fill_random_poisson(&state->rng_poisson, (long int*) state->randnums, batch);
+}
+
+static void run_fill_random_binomial(bench_state_type* state, size_t batch){
+   fill_random_binomial(&state->rng_binomial, (long int*) state->randnums, batch);
+}
+
+static void run_next_random_alias(bench_state_type* state, size_t batch){
+   size_t* randnums = (size_t*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      randnums[i] = next_random_alias(&state->rng_int, &state->alias_table);
+   }
+}
+
+static void run_fill_random_alias(bench_state_type* state, size_t batch){
+   fill_random_alias(&state->rng_int, &state->alias_table, (size_t*) state->randnums, batch);
+}
+
+static void run_rng_shuffle(bench_state_type* state, size_t batch){
+   rng_shuffle(&state->rng_int, state->randnums, batch, sizeof(uint64_t));
+}
+
+static void run_rng_shuffle_blocked(bench_state_type* state, size_t batch){
+   rng_shuffle_blocked(&state->rng_int, state->randnums, batch, sizeof(uint64_t), NULL);
+}
+
+static void run_rng_sample_k(bench_state_type* state, size_t batch){
+   rng_sample_k(&state->rng_int, 1ul<<40, batch, (uint64_t*) state->randnums);
+}
+
+static void run_init_rng_int(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->rng_int = init_rng_int((int) i);
+   }
+}
+
+static void run_init_rng_uniform(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->rng_uniform = init_rng_uniform((int) i, 0.0, 1.0);
+   }
+}
+
+static void run_init_rng_gaussian(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->rng_gaussian = init_rng_gaussian((int) i, 0.0, 1.0);
+   }
+}
+
+static void run_init_rng_gaussian_inplace(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      init_rng_gaussian_inplace(&state->rng_gaussian, (int) i, 0.0, 1.0);
+   }
+}
+
+static void run_init_rng_int_by_array64(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      uint64_t key[2] = {i, ~i};
+      init_rng_int_by_array64(&state->rng_int, key, 2);
+   }
+}
+
+static void run_get_random_state_int(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      char* intstate = get_random_state_int(&state->rng_int);
+      state->sink += (unsigned long int) intstate[1];
+      free(intstate);
+   }
+}
+
+static void run_get_random_state_uniform(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      char* uniformstate = get_random_state_uniform(&state->rng_uniform);
+      state->sink += (unsigned long int) uniformstate[1];
+      free(uniformstate);
+   }
+}
+
+static void run_get_random_state_gaussian(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      char* gaussianstate = get_random_state_gaussian(&state->rng_gaussian);
+      state->sink += (unsigned long int) gaussianstate[1];
+      free(gaussianstate);
+   }
+}
+
+static void run_restore_rng_state_int(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->rng_int = restore_rng_state_int(state->intstate);
+   }
+}
+
+static void run_restore_rng_state_uniform(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->rng_uniform = restore_rng_state_uniform(state->uniformstate);
+   }
+}
+
+static void run_restore_rng_state_gaussian(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->rng_gaussian = restore_rng_state_gaussian(state->gaussianstate);
+   }
+}
+
+static void run_rng_gaussian_serialize(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->sink += rng_gaussian_serialize(&state->rng_gaussian, state->serialstate,
+                                            sizeof(state->serialstate));
+   }
+}
+
+static void run_rng_gaussian_deserialize(bench_state_type* state, size_t batch){
+   for (size_t i=0; i<batch; i++){
+      state->sink += rng_gaussian_deserialize(&state->rng_gaussian, state->serialstate,
+                                              sizeof(state->serialstate));
+   }
+}
+
+static void run_random_r(bench_state_type* state, size_t batch){
+   int* randnums = (int*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      random_r(&state->random_data, randnums+i);
+   }
+}
+
+static void run_std_mt19937_64(bench_state_type* state, size_t batch){
+   bench_std_mt19937_64_fill(state->std_mt, (unsigned long int*) state->randnums, batch);
+}
+
+static void run_int_engine(bench_state_type* state, size_t batch){
+   bench_int_engine_fill(state->int_engine, (unsigned long int*) state->randnums, batch);
+}
+
+static void run_cdf_binary_search(bench_state_type* state, size_t batch){
+   size_t* randnums = (size_t*) state->randnums;
+   for (size_t i=0; i<batch; i++){
+      double u = next_random_uniform(&state->rng_uniform);
+      size_t lower = 0;
+      size_t upper = BENCHOUTCOMES-1;
+      while (lower < upper){
+         size_t middle = (lower + upper) / 2;
+         if (state->cdf[middle] < u){
+            lower = middle + 1;
+         } else {
+            upper = middle;
+         }
+      }
+      randnums[i] = lower;
+   }
+}
+
+static const bench_case_type bench_cases[] = {
+   {"next_random_int", sizeof(int), 0, run_next_random_int},
+   {"next_random_lint", sizeof(long int), 0, run_next_random_lint},
+   {"next_random_uniform", sizeof(double), 0, run_next_random_uniform},
+   {"next_random_lint_inline", sizeof(long int), 0, run_next_random_lint_inline},
+   {"next_random_uniform_inline", sizeof(double), 0, run_next_random_uniform_inline},
+   {"next_random_gaussian", sizeof(double), 0, run_next_random_gaussian},
+   {"next_random_range", sizeof(uint64_t), 0, run_next_random_range},
+   {"next_random_int32", sizeof(int), 0, run_next_random_int32},
+   {"next_random_int_mt32", sizeof(int), 0, run_next_random_int_mt32},
+   {"next_random_lint_sfmt", sizeof(long int), 0, run_next_random_lint_sfmt},
+   {"next_random_uniform_dsfmt", sizeof(double), 0, run_next_random_uniform_dsfmt},
+   {"next_random_float", sizeof(float), 0, run_next_random_float},
+   {"next_random_lint_incremental", sizeof(long int), 0, run_next_random_lint_incremental},
+   {"next_random_exponential", sizeof(double), 0, run_next_random_exponential},
+   {"next_random_gaussian_async", sizeof(double), 0, run_next_random_gaussian_async},
+   {"fill_random_int", sizeof(int), 0, run_fill_random_int},
+   {"fill_random_lint", sizeof(long int), 0, run_fill_random_lint},
+   {"fill_random_uniform", sizeof(double), 0, run_fill_random_uniform},
+   {"fill_random_uniform_closed_open", sizeof(double), 0, run_fill_random_uniform_closed_open},
+   {"fill_random_gaussian", sizeof(double), 0, run_fill_random_gaussian},
+   {"fill_random_gaussian_simd", sizeof(double), 0, run_fill_random_gaussian_simd},
+   {"fill_random_range", sizeof(uint64_t), 0, run_fill_random_range},
+   {"fill_random_int32", sizeof(int), 0, run_fill_random_int32},
+   {"fill_random_int_mt32", sizeof(int), 0, run_fill_random_int_mt32},
+   {"fill_random_int_sfmt", sizeof(int), 0, run_fill_random_int_sfmt},
+   {"fill_random_lint_sfmt", sizeof(long int), 0, run_fill_random_lint_sfmt},
+   {"fill_random_uniform_dsfmt", sizeof(double), 0, run_fill_random_uniform_dsfmt},
+   {"fill_random_float", sizeof(float), 0, run_fill_random_float},
+   {"fill_random_exponential", sizeof(double), 0, run_fill_random_exponential},
+   {"fill_random_gamma", sizeof(double), 0, run_fill_random_gamma},
+   {"fill_random_poisson", sizeof(long int), 0, run_fill_random_poisson},
+   {"fill_random_binomial", sizeof(long int), 0, run_fill_random_binomial},
+   {"next_random_alias", sizeof(size_t), 0, run_next_random_alias},
+   {"fill_random_alias", sizeof(size_t), 0, run_fill_random_alias},
+   {"rng_shuffle", sizeof(uint64_t), 0, run_rng_shuffle},
+   {"rng_shuffle_blocked", sizeof(uint64_t), 0, run_rng_shuffle_blocked},
+   {"rng_sample_k", sizeof(uint64_t), 0, run_rng_sample_k},
+   {"init_rng_int", sizeof(rng_int_type), 4096, run_init_rng_int},
+   {"init_rng_uniform", sizeof(rng_uniform_type), 4096, run_init_rng_uniform},
+   {"init_rng_gaussian", sizeof(rng_gaussian_type), 4096, run_init_rng_gaussian},
+   {"init_rng_gaussian_inplace", sizeof(rng_gaussian_type), 4096, run_init_rng_gaussian_inplace},
+   {"init_rng_int_by_array64", sizeof(rng_int_type), 4096, run_init_rng_int_by_array64},
+   {"get_random_state_int", sizeof(rng_int_type), 64, run_get_random_state_int},
+   {"get_random_state_uniform", sizeof(rng_uniform_type), 64, run_get_random_state_uniform},
+   {"get_random_state_gaussian", sizeof(rng_gaussian_type), 64, run_get_random_state_gaussian},
+   {"restore_rng_state_int", sizeof(rng_int_type), 64, run_restore_rng_state_int},
+   {"restore_rng_state_uniform", sizeof(rng_uniform_type), 64, run_restore_rng_state_uniform},
+   {"restore_rng_state_gaussian", sizeof(rng_gaussian_type), 64, run_restore_rng_state_gaussian},
+   {"rng_gaussian_serialize", sizeof(rng_gaussian_type), 4096, run_rng_gaussian_serialize},
+   {"rng_gaussian_deserialize", sizeof(rng_gaussian_type), 4096, run_rng_gaussian_deserialize},
+   {"glibc_random_r", sizeof(int), 0, run_random_r},
+   {"std_mt19937_64", sizeof(long int), 0, run_std_mt19937_64},
+   {"mt_random::int_engine", sizeof(long int), 0, run_int_engine},
+   {"cdf_binary_search", sizeof(size_t), 0, run_cdf_binary_search}
+};
+
+#define NBENCHCASES (sizeof(bench_cases)/sizeof(bench_cases[0]))
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    A latency case, draws a single number per call
+// Variables:
+//    name: name of the case
+//    draw: draws one number from a state
+/////////////////////////////////////////////////////////////////////////////
+typedef struct latency_case_s {
+   const char* name ;
+   long int (*draw)(bench_state_type* state) ;
+} latency_case_type;
+
+static long int draw_next_random_lint(bench_state_type* state){
+   return next_random_lint(&state->rng_int);
+}
+
+static long int draw_next_random_lint_incremental(bench_state_type* state){
+   return next_random_lint_incremental(&state->rng_int_incremental);
+}
+
+static const latency_case_type latency_cases[] = {
+   {"next_random_lint", draw_next_random_lint},
+   {"next_random_lint_incremental", draw_next_random_lint_incremental}
+};
+
+#define NLATENCYCASES (sizeof(latency_cases)/sizeof(latency_cases[0]))
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Settings of the benchmark
+/////////////////////////////////////////////////////////////////////////////
+typedef struct bench_settings_s {
+   bool csv ;
+   int reps ;
+   int warmup ;
+   double mintime ;
+   int nthreads ;
+   size_t threads[MAXLISTLENGTH] ;
+   int nbatches ;
+   size_t batches[MAXLISTLENGTH] ;
+   const char* filter ;
+   bool latency ;
+   size_t samples ;
+} bench_settings_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Work shared between the threads of a measurement. The threads meet
+//    at the barrier before and after every run.
+// Variables:
+//    barrier: synchronizes the runs
+//    benchcase: case to run
+//    batch: batch size
+//    ncalls: number of calls per run, 0 ends the threads
+/////////////////////////////////////////////////////////////////////////////
+typedef struct bench_shared_s {
+   pthread_barrier_t barrier ;
+   const bench_case_type* benchcase ;
+   size_t batch ;
+   size_t ncalls ;
+} bench_shared_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Data of a benchmark thread
+// Variables:
+//    shared: work shared between the threads
+//    state: state of the thread
+/////////////////////////////////////////////////////////////////////////////
+typedef struct bench_thread_s {
+   bench_shared_type* shared ;
+   bench_state_type state ;
+} bench_thread_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns the current time in seconds
+/////////////////////////////////////////////////////////////////////////////
+static double bench_time(void){
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double) ts.tv_sec + 1.0e-9*(double) ts.tv_nsec;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Sets up the state of a thread
+// Variables:
+//    state: state of the thread
+//    seed: seed of the thread
+//    maxbatch: largest batch size
+/////////////////////////////////////////////////////////////////////////////
+static void init_bench_state(bench_state_type* state, int seed, size_t maxbatch){
+   state->rng_int = init_rng_int(seed);
+   state->rng_uniform = init_rng_uniform(seed, 0.0, 1.0);
+   state->rng_gaussian = init_rng_gaussian(seed, 0.0, 1.0);
+   state->rng_int32 = init_rng_int32(seed);
+   state->rng_float = init_rng_float(seed, 0.0f, 1.0f);
+   state->rng_mt32 = init_rng_mt32(seed);
+   state->rng_sfmt = init_rng_sfmt(seed);
+   state->rng_dsfmt = init_rng_dsfmt(seed, 0.0, 1.0);
+   state->rng_int_incremental = init_rng_int_incremental(seed);
+   state->rng_exponential = init_rng_exponential(seed, 1.0);
+   state->rng_gamma = init_rng_gamma(seed, 2.5, 1.0);
+   state->rng_poisson = init_rng_poisson(seed, 37.5);
+   state->rng_binomial = init_rng_binomial(seed, 1000, 0.3);
+   state->async_gaussian = create_rng_async_gaussian(&state->rng_gaussian, 1ul<<16);
+
+   memset(&state->random_data, 0, sizeof(state->random_data));
+   initstate_r((unsigned int) seed, state->random_statebuf, RANDOMRSTATELENGTH, &state->random_data);
+   state->std_mt = bench_std_mt19937_64_create((unsigned long int) seed);
+   state->int_engine = bench_int_engine_create(seed);
+
+   // zipf distribution
+   double* weights = (double*) malloc(BENCHOUTCOMES*sizeof(double));
+   state->cdf = (double*) malloc(BENCHOUTCOMES*sizeof(double));
+   if (weights == NULL || state->cdf == NULL){
+      fprintf(stderr, "Error in allocating benchmark distribution.");
+      abort();
+   }
+   double sum = 0.0;
+   for (size_t i=0; i<BENCHOUTCOMES; i++){
+      weights[i] = 1.0 / (double) (i+1);
+      sum += weights[i];
+      state->cdf[i] = sum;
+   }
+   for (size_t i=0; i<BENCHOUTCOMES; i++){
+      state->cdf[i] /= sum;
+   }
+   state->alias_table = init_alias_table(weights, BENCHOUTCOMES);
+   free(weights);
+
+   state->randnums = malloc(maxbatch*sizeof(double));
+   if (state->randnums == NULL){
+      fprintf(stderr, "Error in allocating benchmark buffer.");
+      abort();
+   }
+   memset(state->randnums, 0, maxbatch*sizeof(double));
+
+   state->intstate = get_random_state_int(&state->rng_int);
+   state->uniformstate = get_random_state_uniform(&state->rng_uniform);
+   state->gaussianstate = get_random_state_gaussian(&state->rng_gaussian);
+   rng_gaussian_serialize(&state->rng_gaussian, state->serialstate, sizeof(state->serialstate));
+   state->sink = 0;
+}
+
+static void free_bench_state(bench_state_type* state){
+   bench_std_mt19937_64_destroy(state->std_mt);
+   bench_int_engine_destroy(state->int_engine);
+   free_rng_async(state->async_gaussian);
+   free_alias_table(&state->alias_table);
+   free(state->cdf);
+   free(state->randnums);
+   free(state->intstate);
+   free(state->uniformstate);
+   free(state->gaussianstate);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Runs the current case between two barriers
+// Variables:
+//    thread: thread data
+// Return value:
+//    running: Boolean if the thread should continue
+/////////////////////////////////////////////////////////////////////////////
+static bool bench_run(bench_thread_type* thread){
+   bench_shared_type* shared = thread->shared;
+   pthread_barrier_wait(&shared->barrier);
+   if (shared->ncalls == 0) {return false;}
+   for (size_t icall=0; icall<shared->ncalls; icall++){
+      shared->benchcase->run(&thread->state, shared->batch);
+   }
+   pthread_barrier_wait(&shared->barrier);
+   return true;
+}
+
+static void* bench_worker(void* arg){
+   while (bench_run((bench_thread_type*) arg)) {}
+   return NULL;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Times a run of all threads. The calling thread acts as thread 0.
+// Variables:
+//    thread0: data of the calling thread
+//    ncalls: number of calls per run
+// Return value:
+//    duration: wall time of the run in seconds
+/////////////////////////////////////////////////////////////////////////////
+static double bench_timed_run(bench_thread_type* thread0, size_t ncalls){
+   thread0->shared->ncalls = ncalls;
+   double start = bench_time();
+   bench_run(thread0);
+   return bench_time() - start;
+}
+
+static int compare_doubles(const void* a, const void* b){
+   double da = *(const double*) a;
+   double db = *(const double*) b;
+   return (da > db) - (da < db);
+}
+
+static double percentile(const double* sorted, int n, double p){
+   return sorted[(int) (p*(n-1) + 0.5)];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Measures all cases and batch sizes with a fixed number of threads
+// Variables:
+//    settings: settings of the benchmark
+//    nthreads: number of threads
+/////////////////////////////////////////////////////////////////////////////
+static void bench_threads(const bench_settings_type* settings, int nthreads){
+   size_t maxbatch = 1;
+   for (int ibatch=0; ibatch<settings->nbatches; ibatch++){
+      if (settings->batches[ibatch] > maxbatch) {maxbatch = settings->batches[ibatch];}
+   }
+
+   bench_shared_type shared;
+   pthread_barrier_init(&shared.barrier, NULL, (unsigned int) nthreads);
+   bench_thread_type* threads = (bench_thread_type*) malloc(nthreads*sizeof(bench_thread_type));
+   pthread_t* pthreads = (pthread_t*) malloc(nthreads*sizeof(pthread_t));
+   double* samples = (double*) malloc(settings->reps*sizeof(double));
+   if (threads == NULL || pthreads == NULL || samples == NULL){
+      fprintf(stderr, "Error in allocating benchmark threads.");
+      abort();
+   }
+
+   shared.benchcase = &bench_cases[0];
+   shared.batch = 1;
+   shared.ncalls = 1;
+   for (int ithread=0; ithread<nthreads; ithread++){
+      threads[ithread].shared = &shared;
+      init_bench_state(&threads[ithread].state, 12345+ithread, maxbatch);
+      if (ithread > 0 && pthread_create(&pthreads[ithread], NULL, bench_worker, &threads[ithread]) != 0){
+         fprintf(stderr, "Error in creating benchmark thread.");
+         abort();
+      }
+   }
+
+   for (size_t icase=0; icase<NBENCHCASES; icase++){
+      const bench_case_type* benchcase = &bench_cases[icase];
+      if (settings->filter != NULL && strstr(benchcase->name, settings->filter) == NULL) {continue;}
+
+      for (int ibatch=0; ibatch<settings->nbatches; ibatch++){
+         size_t batch = settings->batches[ibatch];
+         if (benchcase->maxbatch > 0 && batch > benchcase->maxbatch) {continue;}
+         shared.benchcase = benchcase;
+         shared.batch = batch;
+
+         // calibrate the number of calls per run
+         size_t ncalls = 1;
+         while (bench_timed_run(threads, ncalls) < settings->mintime){
+            ncalls *= 2;
+         }
+         for (int iwarmup=0; iwarmup<settings->warmup; iwarmup++){
+            bench_timed_run(threads, ncalls);
+         }
+
+         for (int irep=0; irep<settings->reps; irep++){
+            samples[irep] = bench_timed_run(threads, ncalls) / (double) (ncalls*batch);
+         }
+         qsort(samples, settings->reps, sizeof(double), compare_doubles);
+
+         double median = percentile(samples, settings->reps, 0.5);
+         double gbps = (double) (nthreads*benchcase->valuebytes) / median * 1.0e-9;
+         if (settings->csv){
+            printf("%s,%d,%zu,%d,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                   benchcase->name, nthreads, batch, settings->reps,
+                   1.0e9*median, 1.0e9*percentile(samples, settings->reps, 0.1),
+                   1.0e9*percentile(samples, settings->reps, 0.9),
+                   1.0e9*samples[0], gbps);
+         } else {
+            printf("%-32s %7d %8zu %12.3f %10.3f %10.3f %10.3f\n",
+                   benchcase->name, nthreads, batch, 1.0e9*median,
+                   1.0e9*percentile(samples, settings->reps, 0.1),
+                   1.0e9*percentile(samples, settings->reps, 0.9), gbps);
+         }
+         fflush(stdout);
+      }
+   }
+
+   // release the worker threads
+   shared.ncalls = 0;
+   pthread_barrier_wait(&shared.barrier);
+   for (int ithread=0; ithread<nthreads; ithread++){
+      if (ithread > 0) {pthread_join(pthreads[ithread], NULL);}
+      free_bench_state(&threads[ithread].state);
+   }
+   pthread_barrier_destroy(&shared.barrier);
+   free(samples);
+   free(pthreads);
+   free(threads);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Measures the duration of single calls of the latency cases. The timer
+//    overhead is included in every sample and the same for all cases.
+// Variables:
+//    settings: settings of the benchmark
+/////////////////////////////////////////////////////////////////////////////
+static void bench_latency(const bench_settings_type* settings){
+   bench_state_type state;
+   init_bench_state(&state, 12345, 1);
+   double* samples = (double*) malloc(settings->samples*sizeof(double));
+   if (samples == NULL){
+      fprintf(stderr, "Error in allocating latency samples.");
+      abort();
+   }
+
+   for (size_t icase=0; icase<NLATENCYCASES; icase++){
+      const latency_case_type* latencycase = &latency_cases[icase];
+      if (settings->filter != NULL && strstr(latencycase->name, settings->filter) == NULL) {continue;}
+
+      for (size_t isample=0; isample<settings->samples; isample++){
+         state.sink += (unsigned long int) latencycase->draw(&state);
+      }
+      for (size_t isample=0; isample<settings->samples; isample++){
+         double start = bench_time();
+         state.sink += (unsigned long int) latencycase->draw(&state);
+         samples[isample] = bench_time() - start;
+      }
+      qsort(samples, settings->samples, sizeof(double), compare_doubles);
+
+      int n = (int) settings->samples;
+      if (settings->csv){
+         printf("%s,%zu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+                latencycase->name, settings->samples,
+                1.0e9*percentile(samples, n, 0.5), 1.0e9*percentile(samples, n, 0.9),
+                1.0e9*percentile(samples, n, 0.99), 1.0e9*percentile(samples, n, 0.999),
+                1.0e9*percentile(samples, n, 0.9999), 1.0e9*samples[n-1]);
+      } else {
+         printf("%-28s %10zu %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f\n",
+                latencycase->name, settings->samples,
+                1.0e9*percentile(samples, n, 0.5), 1.0e9*percentile(samples, n, 0.9),
+                1.0e9*percentile(samples, n, 0.99), 1.0e9*percentile(samples, n, 0.999),
+                1.0e9*percentile(samples, n, 0.9999), 1.0e9*samples[n-1]);
+      }
+      fflush(stdout);
+   }
+
+   free_bench_state(&state);
+   free(samples);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reads a comma separated list of positive numbers
+// Variables:
+//    text: list to read
+//    list: array to hold the numbers
+// Return value:
+//    n: number of entries
+/////////////////////////////////////////////////////////////////////////////
+static int parse_list(const char* text, size_t* list){
+   int n = 0;
+   char* end;
+   while (n < MAXLISTLENGTH){
+      unsigned long int value = strtoul(text, &end, 10);
+      if (end == text || value == 0){
+         fprintf(stderr, "Invalid list entry in \"%s\"\n", text);
+         exit(EXIT_FAILURE);
+      }
+      list[n++] = value;
+      if (*end != ',') {break;}
+      text = end+1;
+   }
+   return n;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Drains a small ring of int numbers with single values and with acquired
+//    batches and compares them with a plain generator of the same seed.
+//    With 64 slots the producer refills the ring all the time, so a number
+//    it overwrites before the consumer has read it shows up as a mismatch.
+// Return value:
+//    ok: Boolean if all numbers match
+/////////////////////////////////////////////////////////////////////////////
+static bool check_async_ring(void){
+   rng_int_type rng_int = init_rng_int(5489);
+   rng_async_type* async = create_rng_async_int(&rng_int, 64);
+   bool ok = true;
+   size_t ndone = 0;
+   while (ndone < 4000000 && ok){
+      // odd lengths shift the reads against the chunks of the producer
+      for (size_t i=0; i<1000003 && ok; i++){
+         ok = next_random_lint_async(async) == next_random_lint(&rng_int);
+      }
+      ndone += 1000003;
+      for (size_t i=0; i<1000 && ok; i++){
+         const long int* randnums;
+         size_t n = acquire_random_lint_async(async, &randnums);
+         if (n > 7) {n = 7;}
+         for (size_t j=0; j<n; j++){
+            ok = ok && randnums[j] == next_random_lint(&rng_int);
+         }
+         release_random_async(async, n);
+         ndone += n;
+      }
+   }
+   free_rng_async(async);
+   return ok;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Compares the generators with the published outputs of mt19937-64.c,
+//    mt19937ar.c, SFMT and dSFMT (and the C++ standard for the 10000th
+//    number) and the async ring with a plain generator. Timing a wrong
+//    generator is pointless.
+// Return value:
+//    nfailed: number of generators with a wrong output
+/////////////////////////////////////////////////////////////////////////////
+static int check_known_answers(void){
+   int nfailed = 0;
+
+   // 10000th number for seed 5489 (std::mt19937_64 and std::mt19937)
+   rng_int_type rng_int = init_rng_int(5489);
+   unsigned long int lastlint = 0;
+   for (int i=0; i<10000; i++){
+      lastlint = (unsigned long int) next_random_lint(&rng_int);
+   }
+   if (lastlint != 9981545732273789042ul){
+      fprintf(stderr, "Known answer check failed for MT19937-64\n");
+      nfailed++;
+   }
+
+   const uint32_t mt32key[4] = {0x123, 0x234, 0x345, 0x456};
+   const uint32_t mt32answers[5] = {1067595299u, 955945823u, 477289528u, 4107218783u, 4228976476u};
+   rng_mt32_type rng_mt32;
+   init_rng_mt32_by_array(&rng_mt32, mt32key, 4);
+   bool mt32ok = true;
+   for (int i=0; i<5; i++){
+      mt32ok = mt32ok && (uint32_t) next_random_int_mt32(&rng_mt32) == mt32answers[i];
+   }
+   rng_mt32 = init_rng_mt32(5489);
+   uint32_t lastint = 0;
+   for (int i=0; i<10000; i++){
+      lastint = (uint32_t) next_random_int_mt32(&rng_mt32);
+   }
+   if (!mt32ok || lastint != 4123659995u){
+      fprintf(stderr, "Known answer check failed for MT19937\n");
+      nfailed++;
+   }
+
+   const uint32_t sfmtanswers[5] = {3440181298u, 1564997079u, 1510669302u, 2930277156u, 1452439940u};
+   const uint64_t sfmtanswers64[3] = {16924766246869039260ul, 8201438687333352714ul,
+                                      2265290287015001750ul};
+   rng_sfmt_type rng_sfmt = init_rng_sfmt(1234);
+   bool sfmtok = true;
+   for (int i=0; i<5; i++){
+      sfmtok = sfmtok && (uint32_t) next_random_int_sfmt(&rng_sfmt) == sfmtanswers[i];
+   }
+   rng_sfmt = init_rng_sfmt(4321);
+   for (int i=0; i<3; i++){
+      sfmtok = sfmtok && (uint64_t) next_random_lint_sfmt(&rng_sfmt) == sfmtanswers64[i];
+   }
+   if (!sfmtok){
+      fprintf(stderr, "Known answer check failed for SFMT19937\n");
+      nfailed++;
+   }
+
+   // published with 15 decimals in [1,2)
+   const double dsfmtanswers[4] = {1.030581026769374, 1.213140320067012,
+                                   1.299002525016001, 1.381138853044628};
+   rng_dsfmt_type rng_dsfmt = init_rng_dsfmt(0, 1.0, 2.0);
+   bool dsfmtok = true;
+   for (int i=0; i<4; i++){
+      dsfmtok = dsfmtok && fabs(next_random_uniform_dsfmt(&rng_dsfmt) - dsfmtanswers[i]) < 1.0e-15;
+   }
+   if (!dsfmtok){
+      fprintf(stderr, "Known answer check failed for dSFMT19937\n");
+      nfailed++;
+   }
+
+   if (!check_async_ring()){
+      fprintf(stderr, "Consistency check failed for the async ring\n");
+      nfailed++;
+   }
+
+   return nfailed;
+}
+
+int main(int argc, char** argv){
+   bench_settings_type settings = {false, 15, 3, 1.0e-3,
+                                   3, {1, 2, 4},
+                                   4, {1, 64, 4096, 262144},
+                                   NULL, false, 1000000};
+
+   for (int iarg=1; iarg<argc; iarg++){
+      bool hasvalue = iarg+1 < argc;
+      if (strcmp(argv[iarg], "-csv") == 0){
+         settings.csv = true;
+      } else if (strcmp(argv[iarg], "-reps") == 0 && hasvalue){
+         settings.reps = atoi(argv[++iarg]);
+      } else if (strcmp(argv[iarg], "-warmup") == 0 && hasvalue){
+         settings.warmup = atoi(argv[++iarg]);
+      } else if (strcmp(argv[iarg], "-mintime") == 0 && hasvalue){
+         settings.mintime = atof(argv[++iarg]);
+      } else if (strcmp(argv[iarg], "-threads") == 0 && hasvalue){
+         settings.nthreads = parse_list(argv[++iarg], settings.threads);
+      } else if (strcmp(argv[iarg], "-batches") == 0 && hasvalue){
+         settings.nbatches = parse_list(argv[++iarg], settings.batches);
+      } else if (strcmp(argv[iarg], "-filter") == 0 && hasvalue){
+         settings.filter = argv[++iarg];
+      } else if (strcmp(argv[iarg], "-latency") == 0){
+         settings.latency = true;
+      } else if (strcmp(argv[iarg], "-samples") == 0 && hasvalue){
+         settings.samples = strtoul(argv[++iarg], NULL, 10);
+      } else {
+         fprintf(stderr, "Usage: %s [-csv] [-reps n] [-warmup n] [-mintime s] "
+                         "[-threads list] [-batches list] [-filter text] "
+                         "[-latency] [-samples n]\n", argv[0]);
+         return EXIT_FAILURE;
+      }
+   }
+   if (settings.reps < 1) {settings.reps = 1;}
+   if (settings.samples < 1) {settings.samples = 1;}
+
+   if (check_known_answers() > 0){
+      return EXIT_FAILURE;
+   }
+
+   if (settings.latency){
+      if (settings.csv){
+         printf("case,samples,ns_p50,ns_p90,ns_p99,ns_p999,ns_p9999,ns_max\n");
+      } else {
+         printf("%-28s %10s %8s %8s %8s %8s %8s %8s\n",
+                "case", "samples", "p50", "p90", "p99", "p99.9", "p99.99", "max");
+      }
+      bench_latency(&settings);
+      return EXIT_SUCCESS;
+   }
+
+   if (settings.csv){
+      printf("case,threads,batch,reps,ns_median,ns_p10,ns_p90,ns_min,gbps_median\n");
+   } else {
+      printf("%-32s %7s %8s %12s %10s %10s %10s\n",
+             "case", "threads", "batch", "ns/value", "p10", "p90", "GB/s");
+   }
+
+   for (int ithread=0; ithread<settings.nthreads; ithread++){
+      bench_threads(&settings, (int) settings.threads[ithread]);
+   }
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// Description:
+//    C++ standard library engine for comparison in the benchmark and the
+//    C++ engine of MT_random.hpp. The engines are only reachable through
+//    the plain C functions below.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <random>
+#include "MT_random.hpp"
+
+extern "C" {
+   void* bench_std_mt19937_64_create(unsigned long int seed);
+   void bench_std_mt19937_64_destroy(void* engine);
+   void bench_std_mt19937_64_fill(void* engine, unsigned long int* randnums, size_t n);
+   void* bench_int_engine_create(int seed);
+   void bench_int_engine_destroy(void* engine);
+   void bench_int_engine_fill(void* engine, unsigned long int* randnums, size_t n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a std::mt19937_64 engine
+// Variables:
+//    seed: The seed
+// Return value:
+//    engine: pointer to the engine
+/////////////////////////////////////////////////////////////////////////////
+void* bench_std_mt19937_64_create(unsigned long int seed){
+   return new std::mt19937_64(seed);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Destroys an engine created by bench_std_mt19937_64_create
+// Variables:
+//    engine: pointer to the engine
+/////////////////////////////////////////////////////////////////////////////
+void bench_std_mt19937_64_destroy(void* engine){
+   delete static_cast<std::mt19937_64*>(engine);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next numbers of the engine
+// Variables:
+//    engine: pointer to the engine
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void bench_std_mt19937_64_fill(void* engine, unsigned long int* randnums, size_t n){
+   std::mt19937_64& mt = *static_cast<std::mt19937_64*>(engine);
+   for (size_t i=0; i<n; i++){
+      randnums[i] = mt();
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a mt_random::int_engine
+// Variables:
+//    seed: The seed
+// Return value:
+//    engine: pointer to the engine
+/////////////////////////////////////////////////////////////////////////////
+void* bench_int_engine_create(int seed){
+   return new mt_random::int_engine(seed);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Destroys an engine created by bench_int_engine_create
+// Variables:
+//    engine: pointer to the engine
+/////////////////////////////////////////////////////////////////////////////
+void bench_int_engine_destroy(void* engine){
+   delete static_cast<mt_random::int_engine*>(engine);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next numbers of the engine one by one
+// Variables:
+//    engine: pointer to the engine
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void bench_int_engine_fill(void* engine, unsigned long int* randnums, size_t n){
+   mt_random::int_engine& mt = *static_cast<mt_random::int_engine*>(engine);
+   for (size_t i=0; i<n; i++){
+      randnums[i] = mt();
+   }
+}
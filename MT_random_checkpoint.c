@@ -0,0 +1,254 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "MT_random.h"
+#include "MT_random_checkpoint.h"
+
+#define CHECKPOINTMAGIC "MTCK"
+#define CHECKPOINTVERSION 1
+#define CHECKPOINTENDIAN 0x0102
+#define CHECKPOINTHEADERSIZE 4096
+#define CHECKPOINTALIGNMENT 64
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Header at the start of a checkpoint file
+/////////////////////////////////////////////////////////////////////////////
+typedef struct checkpoint_header_s {
+   char magic[4] ;
+   unsigned char type ;
+   unsigned char version ;
+   uint16_t endian ;
+   uint32_t mtstatesize ;
+   uint32_t statesize ;
+   uint64_t nstates ;
+   uint64_t offset ;
+   uint64_t stride ;
+} checkpoint_header_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns the size of a state in memory
+// Variables:
+//    type: type tag of the state
+// Return value:
+//    statesize: size in bytes, 0 for unknown types
+/////////////////////////////////////////////////////////////////////////////
+static size_t checkpoint_state_size(char type){
+   switch (type){
+      case RNG_CHECKPOINT_INT:
+         return sizeof(rng_int_type);
+      case RNG_CHECKPOINT_UNIFORM:
+         return sizeof(rng_uniform_type);
+      case RNG_CHECKPOINT_GAUSSIAN:
+         return sizeof(rng_gaussian_type);
+      default:
+         return 0;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Maps a checkpoint file and fills the checkpoint structure from the
+//    header. Closes the file on failure.
+// Variables:
+//    fd: file descriptor opened for reading and writing
+//    mapsize: size of the file in bytes
+// Return value:
+//    checkpoint: opened checkpoint, NULL on failure
+/////////////////////////////////////////////////////////////////////////////
+static rng_checkpoint_type* map_rng_checkpoint(int fd, size_t mapsize){
+   void* map = mmap(NULL, mapsize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   rng_checkpoint_type* checkpoint = (rng_checkpoint_type*) malloc(sizeof(rng_checkpoint_type));
+   if (map == MAP_FAILED || checkpoint == NULL){
+      if (map != MAP_FAILED) {munmap(map, mapsize);}
+      free(checkpoint);
+      close(fd);
+      return NULL;
+   }
+
+   const checkpoint_header_type* header = (const checkpoint_header_type*) map;
+   checkpoint->fd = fd;
+   checkpoint->map = map;
+   checkpoint->mapsize = mapsize;
+   checkpoint->type = (char) header->type;
+   checkpoint->nstates = header->nstates;
+   checkpoint->stride = header->stride;
+   checkpoint->states = (unsigned char*) map + header->offset;
+   return checkpoint;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a checkpoint file and maps it. An existing file is replaced.
+//    The states are zeroed and need to be initialized in place.
+// Variables:
+//    path: path of the file
+//    type: RNG_CHECKPOINT_INT, RNG_CHECKPOINT_UNIFORM or
+//          RNG_CHECKPOINT_GAUSSIAN
+//    nstates: number of states, positive and small enough for the file
+//             size to fit into a size_t
+// Return value:
+//    checkpoint: opened checkpoint, NULL if the file could not be created
+/////////////////////////////////////////////////////////////////////////////
+rng_checkpoint_type* create_rng_checkpoint(const char* path, char type, size_t nstates){
+   size_t statesize = checkpoint_state_size(type);
+   size_t stride = (statesize + CHECKPOINTALIGNMENT - 1) / CHECKPOINTALIGNMENT * CHECKPOINTALIGNMENT;
+   if (statesize == 0 || nstates == 0 ||
+       nstates > (SIZE_MAX - CHECKPOINTHEADERSIZE) / stride){
+      fprintf(stderr, "Error in creating checkpoint of %zu states of type '%c'.", nstates, type);
+      abort();
+   }
+
+   checkpoint_header_type header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.magic, CHECKPOINTMAGIC, 4);
+   header.type = (unsigned char) type;
+   header.version = CHECKPOINTVERSION;
+   header.endian = CHECKPOINTENDIAN;
+   header.mtstatesize = MTSTATESIZE;
+   header.statesize = (uint32_t) statesize;
+   header.nstates = nstates;
+   header.offset = CHECKPOINTHEADERSIZE;
+   header.stride = stride;
+   size_t mapsize = CHECKPOINTHEADERSIZE + nstates*header.stride;
+
+   // the file is extended with zeros, only the header needs to be written
+   int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (fd < 0) {return NULL;}
+   if (ftruncate(fd, (off_t) mapsize) != 0 ||
+       pwrite(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header)){
+      close(fd);
+      return NULL;
+   }
+   return map_rng_checkpoint(fd, mapsize);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Maps an existing checkpoint file
+// Variables:
+//    path: path of the file
+// Return value:
+//    checkpoint: opened checkpoint, NULL if the file is missing, was
+//                written on a machine with a different memory layout or
+//                has an invalid header
+/////////////////////////////////////////////////////////////////////////////
+rng_checkpoint_type* open_rng_checkpoint(const char* path){
+   int fd = open(path, O_RDWR);
+   if (fd < 0) {return NULL;}
+
+   struct stat filestat;
+   checkpoint_header_type header;
+   if (fstat(fd, &filestat) != 0 || filestat.st_size < CHECKPOINTHEADERSIZE ||
+       pread(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header)){
+      close(fd);
+      return NULL;
+   }
+
+   size_t statesize = checkpoint_state_size((char) header.type);
+   size_t filesize = (size_t) filestat.st_size;
+   bool valid = memcmp(header.magic, CHECKPOINTMAGIC, 4) == 0 &&
+                header.version == CHECKPOINTVERSION &&
+                header.endian == CHECKPOINTENDIAN &&
+                header.mtstatesize == MTSTATESIZE &&
+                statesize != 0 && header.statesize == statesize &&
+                header.stride >= statesize && header.stride % CHECKPOINTALIGNMENT == 0 &&
+                header.offset >= sizeof(header) && header.offset % CHECKPOINTALIGNMENT == 0 &&
+                header.nstates > 0 && header.offset <= filesize &&
+                header.nstates <= (filesize - header.offset) / header.stride;
+   if (!valid){
+      close(fd);
+      return NULL;
+   }
+   return map_rng_checkpoint(fd, filesize);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Writes the states of the mapping to the file and waits until it is
+//    done. The file is consistent if no state is advanced meanwhile.
+// Variables:
+//    checkpoint: opened checkpoint
+// Return value:
+//    success: Boolean if the states were written
+/////////////////////////////////////////////////////////////////////////////
+bool sync_rng_checkpoint(rng_checkpoint_type* checkpoint){
+   return msync(checkpoint->map, checkpoint->mapsize, MS_SYNC) == 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Unmaps and closes a checkpoint file, states obtained from it must not
+//    be used anymore
+// Variables:
+//    checkpoint: opened checkpoint
+/////////////////////////////////////////////////////////////////////////////
+void close_rng_checkpoint(rng_checkpoint_type* checkpoint){
+   munmap(checkpoint->map, checkpoint->mapsize);
+   close(checkpoint->fd);
+   free(checkpoint);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns the address of a state after checking type and index
+// Variables:
+//    checkpoint: opened checkpoint
+//    type: expected type tag
+//    index: index of the state
+// Return value:
+//    state: address of the state in the mapping
+/////////////////////////////////////////////////////////////////////////////
+static void* get_rng_checkpoint_state(rng_checkpoint_type* checkpoint, char type, size_t index){
+   if (checkpoint->type != type || index >= checkpoint->nstates){
+      fprintf(stderr, "Error in accessing checkpoint state %zu of type '%c'.", index, type);
+      abort();
+   }
+   return checkpoint->states + index*checkpoint->stride;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns a int state of a checkpoint for use in place
+// Variables:
+//    checkpoint: opened checkpoint of int states
+//    index: index of the state
+// Return value:
+//    rng_int: Random number generator state in the mapping
+/////////////////////////////////////////////////////////////////////////////
+rng_int_type* get_rng_checkpoint_int(rng_checkpoint_type* checkpoint, size_t index){
+   return (rng_int_type*) get_rng_checkpoint_state(checkpoint, RNG_CHECKPOINT_INT, index);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns a uniform state of a checkpoint for use in place
+// Variables:
+//    checkpoint: opened checkpoint of uniform states
+//    index: index of the state
+// Return value:
+//    rng_uniform: Random number generator state in the mapping
+/////////////////////////////////////////////////////////////////////////////
+rng_uniform_type* get_rng_checkpoint_uniform(rng_checkpoint_type* checkpoint, size_t index){
+   return (rng_uniform_type*) get_rng_checkpoint_state(checkpoint, RNG_CHECKPOINT_UNIFORM, index);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns a gaussian state of a checkpoint for use in place
+// Variables:
+//    checkpoint: opened checkpoint of gaussian states
+//    index: index of the state
+// Return value:
+//    rng_gaussian: Random number generator state in the mapping
+/////////////////////////////////////////////////////////////////////////////
+rng_gaussian_type* get_rng_checkpoint_gaussian(rng_checkpoint_type* checkpoint, size_t index){
+   return (rng_gaussian_type*) get_rng_checkpoint_state(checkpoint, RNG_CHECKPOINT_GAUSSIAN, index);
+}
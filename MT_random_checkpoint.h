@@ -0,0 +1,159 @@
+#ifndef MT_RANDOM_CHECKPOINT_H
+#define MT_RANDOM_CHECKPOINT_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to keep many random number states of one type in a
+   //    memory mapped file. The generators run directly on the mapped states,
+   //    so a checkpoint only flushes the mapping to the file and a restart
+   //    maps the file again. Nothing is converted to text.
+   //    The file starts with a page of header data followed by the states,
+   //    each aligned to a cache line:
+   //       bytes  0- 3: magic "MTCK"
+   //       byte      4: type tag 'I', 'U' or 'G'
+   //       byte      5: format version
+   //       bytes  6- 7: 0x0102 in the byte order of the writer
+   //       bytes  8-11: MTSTATESIZE
+   //       bytes 12-15: size of a state in memory
+   //       bytes 16-23: number of states
+   //       bytes 24-31: offset of the first state
+   //       bytes 32-39: distance between two states
+   //    State i is found at offset + i*distance. The states are stored in
+   //    the memory layout of the machine, a file can only be opened on
+   //    machines with the same layout, which is checked by the header.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_checkpoint.h"
+   //    Create a file for nstates states of one type and initialize them:
+   //       checkpoint = create_rng_checkpoint(path, RNG_CHECKPOINT_UNIFORM, nstates) ;
+   //       init_rng_uniform_inplace(get_rng_checkpoint_uniform(checkpoint, i), seed, lower, upper) ;
+   //    Or open an existing file (NULL if it is missing or invalid):
+   //       checkpoint = open_rng_checkpoint(path) ;
+   //    Use the states in place with all routines of MT_random.h:
+   //       rng_stateu = get_rng_checkpoint_uniform(checkpoint, i) ;
+   //       random_number = next_random_uniform(rng_stateu) ;
+   //       (get_rng_checkpoint_int and get_rng_checkpoint_gaussian for the
+   //        other types)
+   //    Take a checkpoint while no state is advanced:
+   //       success = sync_rng_checkpoint(checkpoint) ;
+   //    Unmap the file, the states are written back by the system:
+   //       close_rng_checkpoint(checkpoint) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stdbool.h>
+   #include <stddef.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   #define RNG_CHECKPOINT_INT 'I'
+   #define RNG_CHECKPOINT_UNIFORM 'U'
+   #define RNG_CHECKPOINT_GAUSSIAN 'G'
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold an opened checkpoint file
+   // Variables:
+   //    fd: file descriptor
+   //    map: mapping of the whole file
+   //    mapsize: size of the mapping in bytes
+   //    type: type tag of the states
+   //    nstates: number of states
+   //    stride: distance between two states in bytes
+   //    states: first state in the mapping
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_checkpoint_s {
+      int fd ;
+      void* map ;
+      size_t mapsize ;
+      char type ;
+      size_t nstates ;
+      size_t stride ;
+      unsigned char* states ;
+   } rng_checkpoint_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Creates a checkpoint file and maps it. An existing file is replaced.
+   //    The states are zeroed and need to be initialized in place.
+   // Variables:
+   //    path: path of the file
+   //    type: RNG_CHECKPOINT_INT, RNG_CHECKPOINT_UNIFORM or
+   //          RNG_CHECKPOINT_GAUSSIAN
+   //    nstates: number of states, has to be positive
+   // Return value:
+   //    checkpoint: opened checkpoint, NULL if the file could not be created
+   /////////////////////////////////////////////////////////////////////////////
+   rng_checkpoint_type* create_rng_checkpoint(const char* path, char type, size_t nstates);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Maps an existing checkpoint file
+   // Variables:
+   //    path: path of the file
+   // Return value:
+   //    checkpoint: opened checkpoint, NULL if the file is missing, was
+   //                written on a machine with a different memory layout or
+   //                has an invalid header
+   /////////////////////////////////////////////////////////////////////////////
+   rng_checkpoint_type* open_rng_checkpoint(const char* path);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Writes the states of the mapping to the file and waits until it is
+   //    done. The file is consistent if no state is advanced meanwhile.
+   // Variables:
+   //    checkpoint: opened checkpoint
+   // Return value:
+   //    success: Boolean if the states were written
+   /////////////////////////////////////////////////////////////////////////////
+   bool sync_rng_checkpoint(rng_checkpoint_type* checkpoint);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Unmaps and closes a checkpoint file, states obtained from it must not
+   //    be used anymore
+   // Variables:
+   //    checkpoint: opened checkpoint
+   /////////////////////////////////////////////////////////////////////////////
+   void close_rng_checkpoint(rng_checkpoint_type* checkpoint);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Returns a int state of a checkpoint for use in place
+   // Variables:
+   //    checkpoint: opened checkpoint of int states
+   //    index: index of the state
+   // Return value:
+   //    rng_int: Random number generator state in the mapping
+   /////////////////////////////////////////////////////////////////////////////
+   rng_int_type* get_rng_checkpoint_int(rng_checkpoint_type* checkpoint, size_t index);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Returns a uniform state of a checkpoint for use in place
+   // Variables:
+   //    checkpoint: opened checkpoint of uniform states
+   //    index: index of the state
+   // Return value:
+   //    rng_uniform: Random number generator state in the mapping
+   /////////////////////////////////////////////////////////////////////////////
+   rng_uniform_type* get_rng_checkpoint_uniform(rng_checkpoint_type* checkpoint, size_t index);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Returns a gaussian state of a checkpoint for use in place
+   // Variables:
+   //    checkpoint: opened checkpoint of gaussian states
+   //    index: index of the state
+   // Return value:
+   //    rng_gaussian: Random number generator state in the mapping
+   /////////////////////////////////////////////////////////////////////////////
+   rng_gaussian_type* get_rng_checkpoint_gaussian(rng_checkpoint_type* checkpoint, size_t index);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
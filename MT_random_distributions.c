@@ -0,0 +1,661 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "MT_random.h"
+#include "MT_random_internal.h"
+#include "MT_random_distributions.h"
+
+#define EXPONENTIAL_STATELENGTH (1+17+1+INT_STATELENGTH)
+#define GAMMA_STATELENGTH (1+2*17+1+INT_STATELENGTH)
+#define POISSON_STATELENGTH (1+17+1+INT_STATELENGTH)
+#define BINOMIAL_STATELENGTH (1+2*17+1+INT_STATELENGTH)
+
+#define INV2POW53 (1.0/9007199254740992.0)
+
+// below these means the simple methods are faster than the rejection methods
+#define POISSON_PTRSMIN 10.0
+#define BINOMIAL_BTRDMIN 10.0
+
+// log(k!) - ((k+1/2)log(k+1) - (k+1) + log(2 pi)/2) for k < 10
+static const double stirling_correction_table[10] = {
+   8.10614667953272611e-02, 4.13406959554092970e-02,
+   2.76779256849983384e-02, 2.07906721037650934e-02,
+   1.66446911898211931e-02, 1.38761288230707484e-02,
+   1.18967099458917695e-02, 1.04112652619720962e-02,
+   9.25546218271273285e-03, 8.33056343336287079e-03
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates a uniform random number in the open interval (0,1), so that
+//    logarithms and divisions are always finite
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    randnum: uniform random number
+/////////////////////////////////////////////////////////////////////////////
+static inline double open_uniform(rng_int_type* rng_int){
+   unsigned long int rng = (unsigned long int) next_random_lint(rng_int);
+   return INV2POW53 * ((double)(rng>>11) + 0.5);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Correction term of the Stirling approximation of log(k!)
+// Variables:
+//    k: argument
+// Return value:
+//    fc: log(k!) - ((k+1/2)log(k+1) - (k+1) + log(2 pi)/2)
+/////////////////////////////////////////////////////////////////////////////
+static double stirling_correction(long int k){
+   if (k < 10) {return stirling_correction_table[k];}
+   double invk1sq = 1.0 / ((double)(k+1)*(double)(k+1));
+   return (1.0/12.0 - (1.0/360.0 - invk1sq/1260.0)*invk1sq) / (double)(k+1);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Checks the parameters and computes the constants of the methods
+// Variables:
+//    rng_*: Random number generator state with the parameters set
+/////////////////////////////////////////////////////////////////////////////
+static void setup_exponential(rng_exponential_type* rng_exponential){
+   if (!(rng_exponential->rate > 0.0)){
+      fprintf(stderr, "Error in initializing exponential random number generator.");
+      abort();
+   }
+}
+
+static void setup_gamma(rng_gamma_type* rng_gamma){
+   double shape = rng_gamma->shape;
+   if (!(shape > 0.0) || !(rng_gamma->scale > 0.0)){
+      fprintf(stderr, "Error in initializing gamma random number generator.");
+      abort();
+   }
+
+   // shapes below 1 are sampled as gamma(shape+1)*U^(1/shape)
+   rng_gamma->invshape = 0.0;
+   if (shape < 1.0){
+      rng_gamma->invshape = 1.0/shape;
+      shape += 1.0;
+   }
+   rng_gamma->d = shape - 1.0/3.0;
+   rng_gamma->c = 1.0/sqrt(9.0*rng_gamma->d);
+}
+
+static void setup_poisson(rng_poisson_type* rng_poisson){
+   double mean = rng_poisson->mean;
+   if (!(mean >= 0.0) || isinf(mean)){
+      fprintf(stderr, "Error in initializing poisson random number generator.");
+      abort();
+   }
+
+   rng_poisson->expmean = exp(-mean);
+   rng_poisson->logmean = mean > 0.0 ? log(mean) : 0.0;
+   rng_poisson->b = 0.931 + 2.53*sqrt(mean);
+   rng_poisson->a = -0.059 + 0.02483*rng_poisson->b;
+   rng_poisson->loginvalpha = log(1.1239 + 1.1328/(rng_poisson->b-3.4));
+   rng_poisson->vr = 0.9277 - 3.6224/(rng_poisson->b-2.0);
+}
+
+static void setup_binomial(rng_binomial_type* rng_binomial){
+   long int n = rng_binomial->n;
+   double p = rng_binomial->p;
+   if (n < 0 || !(p >= 0.0 && p <= 1.0)){
+      fprintf(stderr, "Error in initializing binomial random number generator.");
+      abort();
+   }
+
+   // only p <= 0.5 is sampled, larger p count the failures
+   rng_binomial->flipped = p > 0.5;
+   if (rng_binomial->flipped) {p = 1.0 - p;}
+   double q = 1.0 - p;
+
+   rng_binomial->qn = pow(q, (double) n);
+   rng_binomial->r = p/q;
+   rng_binomial->nr = (double)(n+1) * rng_binomial->r;
+   rng_binomial->m = (long int) floor((double)(n+1) * p);
+   rng_binomial->npq = (double) n * p * q;
+
+   double sqrtnpq = sqrt(rng_binomial->npq);
+   rng_binomial->b = 1.15 + 2.53*sqrtnpq;
+   rng_binomial->a = -0.0873 + 0.0248*rng_binomial->b + 0.01*p;
+   rng_binomial->c = (double) n * p + 0.5;
+   rng_binomial->alpha = (2.83 + 5.1/rng_binomial->b) * sqrtnpq;
+   rng_binomial->vr = 0.92 - 4.2/rng_binomial->b;
+   rng_binomial->urvr = 0.86*rng_binomial->vr;
+
+   long int m = rng_binomial->m;
+   double nm = (double)(n-m+1);
+   rng_binomial->h = ((double) m + 0.5) * log(((double) m + 1.0)/(rng_binomial->r*nm))
+                     + stirling_correction(m) + stirling_correction(n-m);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes an exponential random number generator
+// Variables:
+//    seed: The seed
+//    rate: rate of the distribution, needs to be positive
+// Return value:
+//    rng_exponential: exponential random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_exponential_type init_rng_exponential(int seed, double rate){
+   rng_exponential_type rng_exponential;
+   rng_exponential.rate = rate;
+   setup_exponential(&rng_exponential);
+   init_rng_int_inplace(&rng_exponential.rng_int, seed);
+   return rng_exponential;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a gamma random number generator
+// Variables:
+//    seed: The seed
+//    shape: shape of the distribution, needs to be positive
+//    scale: scale of the distribution, needs to be positive
+// Return value:
+//    rng_gamma: gamma random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_gamma_type init_rng_gamma(int seed, double shape, double scale){
+   rng_gamma_type rng_gamma;
+   rng_gamma.shape = shape;
+   rng_gamma.scale = scale;
+   setup_gamma(&rng_gamma);
+   init_rng_int_inplace(&rng_gamma.rng_int, seed);
+   return rng_gamma;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a poisson random number generator
+// Variables:
+//    seed: The seed
+//    mean: mean of the distribution, must not be negative
+// Return value:
+//    rng_poisson: poisson random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_poisson_type init_rng_poisson(int seed, double mean){
+   rng_poisson_type rng_poisson;
+   rng_poisson.mean = mean;
+   setup_poisson(&rng_poisson);
+   init_rng_int_inplace(&rng_poisson.rng_int, seed);
+   return rng_poisson;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a binomial random number generator
+// Variables:
+//    seed: The seed
+//    n: number of trials, must not be negative
+//    p: success probability in [0,1]
+// Return value:
+//    rng_binomial: binomial random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_binomial_type init_rng_binomial(int seed, long int n, double p){
+   rng_binomial_type rng_binomial;
+   rng_binomial.n = n;
+   rng_binomial.p = p;
+   setup_binomial(&rng_binomial);
+   init_rng_int_inplace(&rng_binomial.rng_int, seed);
+   return rng_binomial;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next exponential random number
+// Variables:
+//    rng_exponential: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+double next_random_exponential(rng_exponential_type* rng_exponential){
+   return standard_exponential_ziggurat(&rng_exponential->rng_int) / rng_exponential->rate;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next gamma random number (Marsaglia and Tsang 2000).
+//    A gaussian number x is accepted as d*(1+c*x)^3 most of the time by
+//    the squeeze, otherwise by the logarithmic test.
+// Variables:
+//    rng_gamma: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+double next_random_gamma(rng_gamma_type* rng_gamma){
+   const double d = rng_gamma->d;
+   const double c = rng_gamma->c;
+   double randnum;
+
+   for (;;){
+      double x = standard_normal_ziggurat(&rng_gamma->rng_int);
+      double v = 1.0 + c*x;
+      if (v <= 0.0) {continue;}
+      v = v*v*v;
+      double u = open_uniform(&rng_gamma->rng_int);
+      double xsq = x*x;
+      if (u < 1.0 - 0.0331*xsq*xsq || log(u) < 0.5*xsq + d*(1.0 - v + log(v))){
+         randnum = d*v;
+         break;
+      }
+   }
+
+   if (rng_gamma->invshape > 0.0){
+      randnum *= pow(open_uniform(&rng_gamma->rng_int), rng_gamma->invshape);
+   }
+   return randnum * rng_gamma->scale;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next poisson random number. Small means multiply
+//    uniform numbers until the product drops below exp(-mean), large means
+//    use the transformed rejection with squeeze PTRS (Hoermann 1993).
+// Variables:
+//    rng_poisson: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+long int next_random_poisson(rng_poisson_type* rng_poisson){
+   const double mean = rng_poisson->mean;
+
+   if (mean < POISSON_PTRSMIN){
+      long int k = 0;
+      double product = open_uniform(&rng_poisson->rng_int);
+      while (product > rng_poisson->expmean){
+         k++;
+         product *= open_uniform(&rng_poisson->rng_int);
+      }
+      return k;
+   }
+
+   const double a = rng_poisson->a;
+   const double b = rng_poisson->b;
+   for (;;){
+      double u = open_uniform(&rng_poisson->rng_int) - 0.5;
+      double v = open_uniform(&rng_poisson->rng_int);
+      double us = 0.5 - fabs(u);
+      double k = floor((2.0*a/us + b)*u + mean + 0.43);
+
+      if (us >= 0.07 && v <= rng_poisson->vr) {return (long int) k;}
+      if (k < 0.0 || (us < 0.013 && v > us)) {continue;}
+      if (log(v) + rng_poisson->loginvalpha - log(a/(us*us) + b)
+          <= -mean + k*rng_poisson->logmean - lgamma(k+1.0)){
+         return (long int) k;
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Samples the binomial distribution by inversion, searching the
+//    cumulative distribution from 0 upwards
+// Variables:
+//    rng_binomial: Random number generator state
+// Return value:
+//    randnum: number of successes for p <= 0.5
+/////////////////////////////////////////////////////////////////////////////
+static long int binomial_inversion(rng_binomial_type* rng_binomial){
+   const long int n = rng_binomial->n;
+   for (;;){
+      double u = open_uniform(&rng_binomial->rng_int);
+      double pk = rng_binomial->qn;
+      long int k = 0;
+      while (u > pk && k <= n){
+         u -= pk;
+         k++;
+         pk *= rng_binomial->nr/(double) k - rng_binomial->r;
+      }
+      // only rounding errors can run past n
+      if (k <= n) {return k;}
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Samples the binomial distribution with the transformed rejection
+//    with decomposition BTRD (Hoermann 1993)
+// Variables:
+//    rng_binomial: Random number generator state
+// Return value:
+//    randnum: number of successes for p <= 0.5
+/////////////////////////////////////////////////////////////////////////////
+static long int binomial_btrd(rng_binomial_type* rng_binomial){
+   const long int n = rng_binomial->n;
+   const long int m = rng_binomial->m;
+   const double r = rng_binomial->r;
+   const double nr = rng_binomial->nr;
+   const double npq = rng_binomial->npq;
+   const double a = rng_binomial->a;
+   const double b = rng_binomial->b;
+   const double c = rng_binomial->c;
+   const double vr = rng_binomial->vr;
+
+   for (;;){
+      double u;
+      double v = open_uniform(&rng_binomial->rng_int);
+      // center of the hat that lies inside the distribution
+      if (v <= rng_binomial->urvr){
+         u = v/vr - 0.43;
+         return (long int) floor((2.0*a/(0.5-fabs(u)) + b)*u + c);
+      }
+
+      if (v >= vr){
+         u = open_uniform(&rng_binomial->rng_int) - 0.5;
+      } else {
+         u = v/vr - 0.93;
+         u = (u < 0.0 ? -0.5 : 0.5) - u;
+         v = open_uniform(&rng_binomial->rng_int)*vr;
+      }
+
+      double us = 0.5 - fabs(u);
+      double kd = floor((2.0*a/us + b)*u + c);
+      if (kd < 0.0 || kd > (double) n) {continue;}
+      long int k = (long int) kd;
+      v = v*rng_binomial->alpha/(a/(us*us) + b);
+      long int km = labs(k - m);
+
+      // close to the mode the ratio of the probabilities is evaluated directly
+      if (km <= 15){
+         double f = 1.0;
+         if (m < k){
+            for (long int i=m+1; i<=k; i++) {f *= nr/(double) i - r;}
+         } else if (m > k){
+            for (long int i=k+1; i<=m; i++) {v *= nr/(double) i - r;}
+         }
+         if (v <= f) {return k;}
+         continue;
+      }
+
+      // squeeze with bounds of the logarithm of the ratio
+      v = log(v);
+      double kmd = (double) km;
+      double rho = (kmd/npq) * (((kmd/3.0 + 0.625)*kmd + 1.0/6.0)/npq + 0.5);
+      double t = -kmd*kmd/(2.0*npq);
+      if (v < t - rho) {return k;}
+      if (v > t + rho) {continue;}
+
+      double nm = (double)(n-m+1);
+      double nk = (double)(n-k+1);
+      if (v <= rng_binomial->h + (double)(n+1)*log(nm/nk)
+                + ((double) k + 0.5)*log(nk*r/((double) k + 1.0))
+                - stirling_correction(k) - stirling_correction(n-k)){
+         return k;
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next binomial random number
+// Variables:
+//    rng_binomial: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+long int next_random_binomial(rng_binomial_type* rng_binomial){
+   long int k;
+   if ((double) rng_binomial->n * (rng_binomial->flipped ? 1.0-rng_binomial->p : rng_binomial->p)
+       < BINOMIAL_BTRDMIN){
+      k = binomial_inversion(rng_binomial);
+   } else {
+      k = binomial_btrd(rng_binomial);
+   }
+   return rng_binomial->flipped ? rng_binomial->n - k : k;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next exponential random numbers.
+//    The numbers are identical to n consecutive calls of
+//    next_random_exponential
+// Variables:
+//    rng_exponential: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_exponential(rng_exponential_type* rng_exponential, double* randnums, size_t n){
+   const double rate = rng_exponential->rate;
+   fill_standard_exponential_ziggurat(&rng_exponential->rng_int, randnums, n);
+   for (size_t i=0; i<n; i++){
+      randnums[i] /= rate;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next gamma random numbers.
+//    The numbers are identical to n consecutive calls of next_random_gamma
+// Variables:
+//    rng_gamma: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_gamma(rng_gamma_type* rng_gamma, double* randnums, size_t n){
+   for (size_t i=0; i<n; i++){
+      randnums[i] = next_random_gamma(rng_gamma);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next poisson random numbers.
+//    The numbers are identical to n consecutive calls of next_random_poisson
+// Variables:
+//    rng_poisson: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_poisson(rng_poisson_type* rng_poisson, long int* randnums, size_t n){
+   for (size_t i=0; i<n; i++){
+      randnums[i] = next_random_poisson(rng_poisson);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next binomial random numbers.
+//    The numbers are identical to n consecutive calls of
+//    next_random_binomial
+// Variables:
+//    rng_binomial: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_binomial(rng_binomial_type* rng_binomial, long int* randnums, size_t n){
+   for (size_t i=0; i<n; i++){
+      randnums[i] = next_random_binomial(rng_binomial);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Writes the int state behind the parameters of a state string
+// Variables:
+//    tmpchar: position behind the parameters
+//    rng_int: int random number state
+/////////////////////////////////////////////////////////////////////////////
+static void append_random_state_int(char* tmpchar, rng_int_type* rng_int){
+   char* intstate = get_random_state_int(rng_int);
+
+   *tmpchar = ' ';
+   tmpchar++;
+   strcpy(tmpchar, intstate);
+   free(intstate);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Checks the type of a state string
+// Variables:
+//    state: state string
+//    rngt: expected type character
+//    name: name of the distribution for the error message
+/////////////////////////////////////////////////////////////////////////////
+static void check_state_type(const char* state, char rngt, const char* name){
+   if (state[0] != rngt){
+      fprintf(stderr, "Error in restoring %s random number generator.", name);
+      abort();
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Save rng state to a string
+// Variables:
+//    rng_exponential: Random number generator state
+// Return value:
+//    exponentialstate: that contains all the state information
+/////////////////////////////////////////////////////////////////////////////
+char* get_random_state_exponential(rng_exponential_type* rng_exponential){
+   char* expstate = (char*)malloc(EXPONENTIAL_STATELENGTH*sizeof(char));
+   void* v;
+
+   v = &rng_exponential->rate;
+   sprintf(expstate, "E%17lx", *((unsigned long int*)v));
+   append_random_state_int(expstate+18, &rng_exponential->rng_int);
+
+   return expstate;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Save rng state to a string
+// Variables:
+//    rng_gamma: Random number generator state
+// Return value:
+//    gammastate: that contains all the state information
+/////////////////////////////////////////////////////////////////////////////
+char* get_random_state_gamma(rng_gamma_type* rng_gamma){
+   char* gammastate = (char*)malloc(GAMMA_STATELENGTH*sizeof(char));
+   void* v;
+
+   v = &rng_gamma->shape;
+   sprintf(gammastate, "A%17lx", *((unsigned long int*)v));
+   v = &rng_gamma->scale;
+   sprintf(gammastate+18, "%17lx", *((unsigned long int*)v));
+   append_random_state_int(gammastate+35, &rng_gamma->rng_int);
+
+   return gammastate;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Save rng state to a string
+// Variables:
+//    rng_poisson: Random number generator state
+// Return value:
+//    poissonstate: that contains all the state information
+/////////////////////////////////////////////////////////////////////////////
+char* get_random_state_poisson(rng_poisson_type* rng_poisson){
+   char* poissonstate = (char*)malloc(POISSON_STATELENGTH*sizeof(char));
+   void* v;
+
+   v = &rng_poisson->mean;
+   sprintf(poissonstate, "P%17lx", *((unsigned long int*)v));
+   append_random_state_int(poissonstate+18, &rng_poisson->rng_int);
+
+   return poissonstate;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Save rng state to a string
+// Variables:
+//    rng_binomial: Random number generator state
+// Return value:
+//    binomialstate: that contains all the state information
+/////////////////////////////////////////////////////////////////////////////
+char* get_random_state_binomial(rng_binomial_type* rng_binomial){
+   char* binomialstate = (char*)malloc(BINOMIAL_STATELENGTH*sizeof(char));
+   void* v;
+
+   sprintf(binomialstate, "B%17lx", (unsigned long int) rng_binomial->n);
+   v = &rng_binomial->p;
+   sprintf(binomialstate+18, "%17lx", *((unsigned long int*)v));
+   append_random_state_int(binomialstate+35, &rng_binomial->rng_int);
+
+   return binomialstate;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a string
+// Variables:
+//    exponentialstate: that contains all the state information
+// Return value:
+//    rng_exponential: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+rng_exponential_type restore_rng_state_exponential(char* exponentialstate){
+   rng_exponential_type rng_exponential;
+   check_state_type(exponentialstate, 'E', "exponential");
+
+   sscanf(exponentialstate+1, "%17lx", (unsigned long int*)(void*)&rng_exponential.rate);
+   setup_exponential(&rng_exponential);
+   rng_exponential.rng_int = restore_rng_state_int(exponentialstate+19);
+
+   return rng_exponential;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a string
+// Variables:
+//    gammastate: that contains all the state information
+// Return value:
+//    rng_gamma: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+rng_gamma_type restore_rng_state_gamma(char* gammastate){
+   rng_gamma_type rng_gamma;
+   check_state_type(gammastate, 'A', "gamma");
+
+   sscanf(gammastate+1, "%17lx", (unsigned long int*)(void*)&rng_gamma.shape);
+   sscanf(gammastate+18, "%17lx", (unsigned long int*)(void*)&rng_gamma.scale);
+   setup_gamma(&rng_gamma);
+   rng_gamma.rng_int = restore_rng_state_int(gammastate+36);
+
+   return rng_gamma;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a string
+// Variables:
+//    poissonstate: that contains all the state information
+// Return value:
+//    rng_poisson: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+rng_poisson_type restore_rng_state_poisson(char* poissonstate){
+   rng_poisson_type rng_poisson;
+   check_state_type(poissonstate, 'P', "poisson");
+
+   sscanf(poissonstate+1, "%17lx", (unsigned long int*)(void*)&rng_poisson.mean);
+   setup_poisson(&rng_poisson);
+   rng_poisson.rng_int = restore_rng_state_int(poissonstate+19);
+
+   return rng_poisson;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a string
+// Variables:
+//    binomialstate: that contains all the state information
+// Return value:
+//    rng_binomial: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+rng_binomial_type restore_rng_state_binomial(char* binomialstate){
+   rng_binomial_type rng_binomial;
+   check_state_type(binomialstate, 'B', "binomial");
+
+   sscanf(binomialstate+1, "%17lx", (unsigned long int*)&rng_binomial.n);
+   sscanf(binomialstate+18, "%17lx", (unsigned long int*)(void*)&rng_binomial.p);
+   setup_binomial(&rng_binomial);
+   rng_binomial.rng_int = restore_rng_state_int(binomialstate+36);
+
+   return rng_binomial;
+}
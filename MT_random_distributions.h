@@ -0,0 +1,357 @@
+#ifndef MT_RANDOM_DISTRIBUTIONS_H
+#define MT_RANDOM_DISTRIBUTIONS_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to generate exponential, gamma, poisson and binomial
+   //    distributed pseudo random numbers with the mersenne twister.
+   //    Exponential: ziggurat algorithm (Marsaglia and Tsang 2000)
+   //    Gamma: Marsaglia and Tsang 2000, with ziggurat gaussian numbers
+   //    Poisson: transformed rejection PTRS (Hoermann 1993) for means of 10
+   //             and above, multiplication of uniform numbers below
+   //    Binomial: transformed rejection BTRD (Hoermann 1993) if n*min(p,1-p)
+   //              is 10 and above, inversion below
+   //    The parameter dependent constants of the methods are computed once
+   //    during the initialization and kept in the state.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_distributions.h"
+   //    Initialize the random number state:
+   //       Exponential with rate lambda (mean 1/lambda):
+   //          rng_statee = init_rng_exponential(seed, rate)
+   //       Gamma with shape k and scale theta:
+   //          rng_statea = init_rng_gamma(seed, shape, scale)
+   //       Poisson with mean lambda:
+   //          rng_statep = init_rng_poisson(seed, mean)
+   //       Binomial with n trials of success probability p:
+   //          rng_stateb = init_rng_binomial(seed, n, p)
+   //    Get the next random number:
+   //       random_number = next_random_exponential(&rng_statee) ;
+   //       random_number = next_random_gamma(&rng_statea) ;
+   //       random_number = next_random_poisson(&rng_statep) ;
+   //       random_number = next_random_binomial(&rng_stateb) ;
+   //    Fill an array with the next n random numbers:
+   //       fill_random_exponential(&rng_statee, random_numbers, n) ;
+   //       fill_random_gamma(&rng_statea, random_numbers, n) ;
+   //       fill_random_poisson(&rng_statep, random_numbers, n) ;
+   //       fill_random_binomial(&rng_stateb, random_numbers, n) ;
+   //    Store the state in a string for writeout:
+   //       rng_state_string = get_random_state_exponential(&rng_statee) ;
+   //       rng_state_string = get_random_state_gamma(&rng_statea) ;
+   //       rng_state_string = get_random_state_poisson(&rng_statep) ;
+   //       rng_state_string = get_random_state_binomial(&rng_stateb) ;
+   //    Restore a previously extracted state:
+   //       rng_statee = restore_rng_state_exponential(rng_state_string) ;
+   //       rng_statea = restore_rng_state_gamma(rng_state_string) ;
+   //       rng_statep = restore_rng_state_poisson(rng_state_string) ;
+   //       rng_stateb = restore_rng_state_binomial(rng_state_string) ;
+   //    There is no need for freeing anything except the state string pointer
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stdbool.h>
+   #include <stddef.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of an exponential random number generator
+   // Variables:
+   //    rate: rate of the distribution
+   //    rng_int: int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_exponential_s {
+      double rate ;
+      rng_int_type rng_int ;
+   } rng_exponential_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of a gamma random number generator
+   // Variables:
+   //    shape: shape of the distribution
+   //    scale: scale of the distribution
+   //    d, c: constants of the method for max(shape, shape+1)
+   //    invshape: 1/shape for shapes below 1, else 0
+   //    rng_int: int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_gamma_s {
+      double shape ;
+      double scale ;
+      double d ;
+      double c ;
+      double invshape ;
+      rng_int_type rng_int ;
+   } rng_gamma_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of a poisson random number generator
+   // Variables:
+   //    mean: mean of the distribution
+   //    expmean: exp(-mean) for the multiplication method
+   //    logmean: log(mean)
+   //    a, b, loginvalpha, vr: constants of the PTRS method
+   //    rng_int: int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_poisson_s {
+      double mean ;
+      double expmean ;
+      double logmean ;
+      double a ;
+      double b ;
+      double loginvalpha ;
+      double vr ;
+      rng_int_type rng_int ;
+   } rng_poisson_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of a binomial random number generator
+   // Variables:
+   //    n: number of trials
+   //    p: success probability
+   //    flipped: Boolean if failures are counted because p > 0.5
+   //    qn: (1-p')^n for the inversion with p' = min(p,1-p)
+   //    r, nr: p'/(1-p') and (n+1)*p'/(1-p')
+   //    m, npq, a, b, c, alpha, vr, urvr, h: constants of the BTRD method
+   //    rng_int: int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_binomial_s {
+      long int n ;
+      double p ;
+      bool flipped ;
+      double qn ;
+      double r ;
+      double nr ;
+      long int m ;
+      double npq ;
+      double a ;
+      double b ;
+      double c ;
+      double alpha ;
+      double vr ;
+      double urvr ;
+      double h ;
+      rng_int_type rng_int ;
+   } rng_binomial_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes an exponential random number generator
+   // Variables:
+   //    seed: The seed
+   //    rate: rate of the distribution, needs to be positive
+   // Return value:
+   //    rng_exponential: exponential random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_exponential_type init_rng_exponential(int seed, double rate);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a gamma random number generator
+   // Variables:
+   //    seed: The seed
+   //    shape: shape of the distribution, needs to be positive
+   //    scale: scale of the distribution, needs to be positive
+   // Return value:
+   //    rng_gamma: gamma random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_gamma_type init_rng_gamma(int seed, double shape, double scale);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a poisson random number generator
+   // Variables:
+   //    seed: The seed
+   //    mean: mean of the distribution, must not be negative
+   // Return value:
+   //    rng_poisson: poisson random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_poisson_type init_rng_poisson(int seed, double mean);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a binomial random number generator
+   // Variables:
+   //    seed: The seed
+   //    n: number of trials, must not be negative
+   //    p: success probability in [0,1]
+   // Return value:
+   //    rng_binomial: binomial random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_binomial_type init_rng_binomial(int seed, long int n, double p);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next exponential random number
+   // Variables:
+   //    rng_exponential: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   double next_random_exponential(rng_exponential_type* rng_exponential);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next gamma random number
+   // Variables:
+   //    rng_gamma: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   double next_random_gamma(rng_gamma_type* rng_gamma);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next poisson random number
+   // Variables:
+   //    rng_poisson: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   long int next_random_poisson(rng_poisson_type* rng_poisson);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next binomial random number
+   // Variables:
+   //    rng_binomial: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   long int next_random_binomial(rng_binomial_type* rng_binomial);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next exponential random numbers.
+   //    The numbers are identical to n consecutive calls of
+   //    next_random_exponential
+   // Variables:
+   //    rng_exponential: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_exponential(rng_exponential_type* rng_exponential, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next gamma random numbers.
+   //    The numbers are identical to n consecutive calls of next_random_gamma
+   // Variables:
+   //    rng_gamma: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_gamma(rng_gamma_type* rng_gamma, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next poisson random numbers.
+   //    The numbers are identical to n consecutive calls of next_random_poisson
+   // Variables:
+   //    rng_poisson: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_poisson(rng_poisson_type* rng_poisson, long int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next binomial random numbers.
+   //    The numbers are identical to n consecutive calls of
+   //    next_random_binomial
+   // Variables:
+   //    rng_binomial: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_binomial(rng_binomial_type* rng_binomial, long int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Save rng state to a string
+   // Variables:
+   //    rng_exponential: Random number generator state
+   // Return value:
+   //    exponentialstate: that contains all the state information
+   /////////////////////////////////////////////////////////////////////////////
+   char* get_random_state_exponential(rng_exponential_type* rng_exponential);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Save rng state to a string
+   // Variables:
+   //    rng_gamma: Random number generator state
+   // Return value:
+   //    gammastate: that contains all the state information
+   /////////////////////////////////////////////////////////////////////////////
+   char* get_random_state_gamma(rng_gamma_type* rng_gamma);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Save rng state to a string
+   // Variables:
+   //    rng_poisson: Random number generator state
+   // Return value:
+   //    poissonstate: that contains all the state information
+   /////////////////////////////////////////////////////////////////////////////
+   char* get_random_state_poisson(rng_poisson_type* rng_poisson);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Save rng state to a string
+   // Variables:
+   //    rng_binomial: Random number generator state
+   // Return value:
+   //    binomialstate: that contains all the state information
+   /////////////////////////////////////////////////////////////////////////////
+   char* get_random_state_binomial(rng_binomial_type* rng_binomial);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a string
+   // Variables:
+   //    exponentialstate: that contains all the state information
+   // Return value:
+   //    rng_exponential: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_exponential_type restore_rng_state_exponential(char* exponentialstate);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a string
+   // Variables:
+   //    gammastate: that contains all the state information
+   // Return value:
+   //    rng_gamma: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_gamma_type restore_rng_state_gamma(char* gammastate);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a string
+   // Variables:
+   //    poissonstate: that contains all the state information
+   // Return value:
+   //    rng_poisson: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_poisson_type restore_rng_state_poisson(char* poissonstate);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a string
+   // Variables:
+   //    binomialstate: that contains all the state information
+   // Return value:
+   //    rng_binomial: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_binomial_type restore_rng_state_binomial(char* binomialstate);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
@@ -0,0 +1,798 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "MT_random.h"
+#include "MT_random_engines.h"
+
+#if defined(__SSE2__)
+#define MT_RANDOM_SSE2_KERNELS
+#include <emmintrin.h>
+#endif
+
+// MT19937
+#define MT32N (MT32STATESIZE)
+#define MT32M 397
+#define MT32MATRIXA 0x9908B0DFu
+#define MT32UM 0x80000000u
+#define MT32LM 0x7FFFFFFFu
+
+// SFMT19937, 156 128 bit words
+#define SFMTN (SFMTSTATESIZE/4)
+#define SFMTPOS1 122
+#define SFMTSL1 18
+#define SFMTSL2 1
+#define SFMTSR1 11
+#define SFMTSR2 1
+#define SFMTMSK1 0xDFFFFFEFu
+#define SFMTMSK2 0xDDFECB7Fu
+#define SFMTMSK3 0xBFFAFFFFu
+#define SFMTMSK4 0xBFFFFFF6u
+#define SFMTPARITY1 0x00000001u
+#define SFMTPARITY2 0x00000000u
+#define SFMTPARITY3 0x00000000u
+#define SFMTPARITY4 0x13C9E684u
+
+// dSFMT19937, 191 128 bit words and the lung
+#define DSFMTN (DSFMTSTATESIZE/2-1)
+#define DSFMTN64 (2*DSFMTN)
+#define DSFMTPOS1 117
+#define DSFMTSL1 19
+#define DSFMTSR 12
+#define DSFMTMSK1 0x000FFAFFFFFFFB3Ful
+#define DSFMTMSK2 0x000FFDFFFC90FFFDul
+#define DSFMTFIX1 0x90014964B32F4329ul
+#define DSFMTFIX2 0x3B8D12AC548A7C7Aul
+#define DSFMTPCV1 0x3D84E1AC0DC82880ul
+#define DSFMTPCV2 0x0000000000000001ul
+#define DSFMTLOWMASK 0x000FFFFFFFFFFFFFul
+#define DSFMTHIGHCONST 0x3FF0000000000000ul
+
+#define MT32_STATELENGTH (1+2*9+MT32STATESIZE*9+1)
+#define SFMT_STATELENGTH (1+2*9+SFMTSTATESIZE*9+1)
+#define DSFMT_STATELENGTH (1+2*17+2*9+DSFMTSTATESIZE*17+1)
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills 32 bit words with the initialization recursion shared by
+//    MT19937, SFMT and dSFMT
+// Variables:
+//    words: array to initialize
+//    n: number of words
+//    seed: The seed
+/////////////////////////////////////////////////////////////////////////////
+static void init_words32(uint32_t* words, size_t n, uint32_t seed){
+   words[0] = seed;
+   for (size_t i=1; i<n; i++){
+      words[i] = 1812433253u * (words[i-1] ^ (words[i-1] >> 30)) + (uint32_t) i;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Aborts if a state string belongs to a different generator
+// Variables:
+//    state: state string
+//    rngt: expected type character
+//    name: name of the generator for the error message
+/////////////////////////////////////////////////////////////////////////////
+static void check_state_type(const char* state, char rngt, const char* name){
+   if (state[0] != rngt){
+      fprintf(stderr, "Error in restoring %s random number generator.", name);
+      abort();
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a 32 bit MT19937 random number generator in place
+// Variables:
+//    rng_mt32: MT19937 random number state to initialize
+//    seed: The seed
+/////////////////////////////////////////////////////////////////////////////
+static void init_rng_mt32_inplace(rng_mt32_type* rng_mt32, int seed){
+   rng_mt32->seed = seed;
+   init_words32(rng_mt32->mtstate, MT32N, (uint32_t) seed);
+   rng_mt32->mtidx = MT32N+1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a 32 bit MT19937 random number generator
+// Variables:
+//    seed: The seed
+// Return value:
+//    rng_mt32: MT19937 random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_mt32_type init_rng_mt32(int seed){
+   rng_mt32_type rng_mt32;
+   init_rng_mt32_inplace(&rng_mt32, seed);
+   return rng_mt32;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a 32 bit MT19937 random number generator in place from
+//    an array of 32 bit keys (init_by_array of mt19937ar). The seed member
+//    holds the first key.
+// Variables:
+//    rng_mt32: MT19937 random number state to initialize
+//    key: array of keys
+//    keylength: number of keys, has to be positive
+/////////////////////////////////////////////////////////////////////////////
+void init_rng_mt32_by_array(rng_mt32_type* rng_mt32, const uint32_t* key, size_t keylength){
+   if (keylength == 0){
+      fprintf(stderr, "Error in initializing random number generator from an empty key.");
+      abort();
+   }
+
+   uint32_t* mt = rng_mt32->mtstate;
+   init_rng_mt32_inplace(rng_mt32, 19650218);
+
+   size_t i = 1;
+   size_t j = 0;
+   for (size_t k = MT32N > keylength ? MT32N : keylength; k > 0; k--){
+      mt[i] = (mt[i] ^ ((mt[i-1] ^ (mt[i-1] >> 30)) * 1664525u)) + key[j] + (uint32_t) j;
+      i++;
+      j++;
+      if (i >= MT32N) {mt[0] = mt[MT32N-1]; i = 1;}
+      if (j >= keylength) {j = 0;}
+   }
+   for (size_t k = MT32N-1; k > 0; k--){
+      mt[i] = (mt[i] ^ ((mt[i-1] ^ (mt[i-1] >> 30)) * 1566083941u)) - (uint32_t) i;
+      i++;
+      if (i >= MT32N) {mt[0] = mt[MT32N-1]; i = 1;}
+   }
+   mt[0] = 0x80000000u;
+
+   rng_mt32->seed = (int) key[0];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Computes a single new element of the MT19937 state
+// Variables:
+//    mt: State of the mersenne twister
+//    i: index of the element to update
+//    ip1: index of the following element
+//    ipm: index of the element MT32M positions further
+/////////////////////////////////////////////////////////////////////////////
+static inline void twist_mt32_element(uint32_t* mt, int i, int ip1, int ipm){
+   uint32_t y = (mt[i] & MT32UM) | (mt[ip1] & MT32LM);
+   mt[i] = mt[ipm] ^ (y >> 1) ^ ((0u - (y & 1u)) & MT32MATRIXA);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in the MT19937 state
+// Variables:
+//    rng_mt32: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+static void regenerate_rng_mt32(rng_mt32_type* rng_mt32){
+   uint32_t* mt = rng_mt32->mtstate;
+   int i = 0;
+   for (; i<MT32N-MT32M; i++){
+      twist_mt32_element(mt, i, i+1, i+MT32M);
+   }
+   for (; i<MT32N-1; i++){
+      twist_mt32_element(mt, i, i+1, i+MT32M-MT32N);
+   }
+   twist_mt32_element(mt, MT32N-1, 0, MT32M-1);
+   rng_mt32->mtidx = -1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Mixes up a number from the MT19937 state
+// Variables:
+//    y: Element of the mersenne twister state
+// Return value:
+//    y: tempered random number
+/////////////////////////////////////////////////////////////////////////////
+static inline uint32_t temper_mt32(uint32_t y){
+   y ^= y >> 11;
+   y ^= (y << 7) & 0x9D2C5680u;
+   y ^= (y << 15) & 0xEFC60000u;
+   y ^= y >> 18;
+   return y;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next 32 bit random number of a MT19937 state
+// Variables:
+//    rng_mt32: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+int next_random_int_mt32(rng_mt32_type* rng_mt32){
+   if (rng_mt32->mtidx > MT32N-2){
+      regenerate_rng_mt32(rng_mt32);
+   }
+   rng_mt32->mtidx += 1;
+   return (int) temper_mt32(rng_mt32->mtstate[rng_mt32->mtidx]);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next 32 bit random numbers of a MT19937 state
+//    The numbers are identical to n consecutive calls of
+//    next_random_int_mt32
+// Variables:
+//    rng_mt32: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_int_mt32(rng_mt32_type* rng_mt32, int* randnums, size_t n){
+   while (n > 0){
+      if (rng_mt32->mtidx > MT32N-2){
+         regenerate_rng_mt32(rng_mt32);
+      }
+      size_t nblock = (size_t) (MT32N-1 - rng_mt32->mtidx);
+      if (nblock > n) {nblock = n;}
+
+      const uint32_t* mt = rng_mt32->mtstate + rng_mt32->mtidx + 1;
+      for (size_t i=0; i<nblock; i++){
+         randnums[i] = (int) temper_mt32(mt[i]);
+      }
+
+      rng_mt32->mtidx += (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Makes sure the period of a SFMT19937 state is 2^19937-1
+// Variables:
+//    state: state to check and fix
+/////////////////////////////////////////////////////////////////////////////
+static void certify_period_sfmt(uint32_t* state){
+   const uint32_t parity[4] = {SFMTPARITY1, SFMTPARITY2, SFMTPARITY3, SFMTPARITY4};
+
+   uint32_t inner = 0;
+   for (int i=0; i<4; i++){
+      inner ^= state[i] & parity[i];
+   }
+   for (int i=16; i>0; i>>=1){
+      inner ^= inner >> i;
+   }
+   if (inner & 1u) {return;}
+
+   for (int i=0; i<4; i++){
+      uint32_t work = 1;
+      for (int j=0; j<32; j++){
+         if (work & parity[i]){
+            state[i] ^= work;
+            return;
+         }
+         work <<= 1;
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a SFMT19937 random number generator
+// Variables:
+//    seed: The seed
+// Return value:
+//    rng_sfmt: SFMT19937 random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_sfmt_type init_rng_sfmt(int seed){
+   rng_sfmt_type rng_sfmt;
+   rng_sfmt.seed = seed;
+   init_words32(rng_sfmt.state, SFMTSTATESIZE, (uint32_t) seed);
+   certify_period_sfmt(rng_sfmt.state);
+   rng_sfmt.idx = SFMTSTATESIZE;
+   return rng_sfmt;
+}
+
+#ifdef MT_RANDOM_SSE2_KERNELS
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in a SFMT19937 state,
+//    one 128 bit word per step
+// Variables:
+//    state: State of the generator
+/////////////////////////////////////////////////////////////////////////////
+static void regenerate_sfmt(uint32_t* state){
+   const __m128i mask = _mm_set_epi32((int) SFMTMSK4, (int) SFMTMSK3,
+                                      (int) SFMTMSK2, (int) SFMTMSK1);
+   __m128i* w = (__m128i*) state;
+   __m128i r1 = _mm_loadu_si128(w+SFMTN-2);
+   __m128i r2 = _mm_loadu_si128(w+SFMTN-1);
+
+   for (int i=0; i<SFMTN; i++){
+      int ipos = i < SFMTN-SFMTPOS1 ? i+SFMTPOS1 : i+SFMTPOS1-SFMTN;
+      __m128i a = _mm_loadu_si128(w+i);
+      __m128i y = _mm_and_si128(_mm_srli_epi32(_mm_loadu_si128(w+ipos), SFMTSR1), mask);
+      __m128i z = _mm_xor_si128(a, _mm_slli_si128(a, SFMTSL2));
+      z = _mm_xor_si128(z, _mm_srli_si128(r1, SFMTSR2));
+      z = _mm_xor_si128(z, _mm_slli_epi32(r2, SFMTSL1));
+      z = _mm_xor_si128(z, y);
+      _mm_storeu_si128(w+i, z);
+      r1 = r2;
+      r2 = z;
+   }
+}
+#else
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Computes a new 128 bit word of a SFMT19937 state
+//    r = a ^ (a << 8*SL2) ^ ((b >> SR1) & MSK) ^ (c >> 8*SR2) ^ (d << SL1)
+//    with 128 bit shifts of a and c and 32 bit shifts of b and d
+// Variables:
+//    r: word to store the result, may be a
+//    a, b, c, d: words of the recursion
+/////////////////////////////////////////////////////////////////////////////
+static inline void sfmt_recursion(uint32_t* r, const uint32_t* a, const uint32_t* b,
+                                  const uint32_t* c, const uint32_t* d){
+   uint64_t ah = ((uint64_t) a[3] << 32) | a[2];
+   uint64_t al = ((uint64_t) a[1] << 32) | a[0];
+   uint64_t xh = (ah << (8*SFMTSL2)) | (al >> (64-8*SFMTSL2));
+   uint64_t xl = al << (8*SFMTSL2);
+   uint64_t ch = ((uint64_t) c[3] << 32) | c[2];
+   uint64_t cl = ((uint64_t) c[1] << 32) | c[0];
+   uint64_t yh = ch >> (8*SFMTSR2);
+   uint64_t yl = (cl >> (8*SFMTSR2)) | (ch << (64-8*SFMTSR2));
+
+   uint32_t r0 = a[0] ^ (uint32_t) xl ^ ((b[0] >> SFMTSR1) & SFMTMSK1)
+                 ^ (uint32_t) yl ^ (d[0] << SFMTSL1);
+   uint32_t r1 = a[1] ^ (uint32_t) (xl >> 32) ^ ((b[1] >> SFMTSR1) & SFMTMSK2)
+                 ^ (uint32_t) (yl >> 32) ^ (d[1] << SFMTSL1);
+   uint32_t r2 = a[2] ^ (uint32_t) xh ^ ((b[2] >> SFMTSR1) & SFMTMSK3)
+                 ^ (uint32_t) yh ^ (d[2] << SFMTSL1);
+   uint32_t r3 = a[3] ^ (uint32_t) (xh >> 32) ^ ((b[3] >> SFMTSR1) & SFMTMSK4)
+                 ^ (uint32_t) (yh >> 32) ^ (d[3] << SFMTSL1);
+   r[0] = r0;
+   r[1] = r1;
+   r[2] = r2;
+   r[3] = r3;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in a SFMT19937 state
+// Variables:
+//    state: State of the generator
+/////////////////////////////////////////////////////////////////////////////
+static void regenerate_sfmt(uint32_t* state){
+   const uint32_t* r1 = state + 4*(SFMTN-2);
+   const uint32_t* r2 = state + 4*(SFMTN-1);
+
+   for (int i=0; i<SFMTN; i++){
+      int ipos = i < SFMTN-SFMTPOS1 ? i+SFMTPOS1 : i+SFMTPOS1-SFMTN;
+      sfmt_recursion(state+4*i, state+4*i, state+4*ipos, r1, r2);
+      r1 = r2;
+      r2 = state+4*i;
+   }
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next 32 bit random number of a SFMT19937 state
+// Variables:
+//    rng_sfmt: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+int next_random_int_sfmt(rng_sfmt_type* rng_sfmt){
+   if (rng_sfmt->idx >= SFMTSTATESIZE){
+      regenerate_sfmt(rng_sfmt->state);
+      rng_sfmt->idx = 0;
+   }
+   return (int) rng_sfmt->state[rng_sfmt->idx++];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next 64 bit random number of a SFMT19937 state from
+//    two consecutive 32 bit words. After an odd number of 32 bit numbers
+//    one word is skipped.
+// Variables:
+//    rng_sfmt: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+long int next_random_lint_sfmt(rng_sfmt_type* rng_sfmt){
+   rng_sfmt->idx += rng_sfmt->idx & 1;
+   if (rng_sfmt->idx >= SFMTSTATESIZE){
+      regenerate_sfmt(rng_sfmt->state);
+      rng_sfmt->idx = 0;
+   }
+   const uint32_t* words = rng_sfmt->state + rng_sfmt->idx;
+   rng_sfmt->idx += 2;
+   return (long int) (((uint64_t) words[1] << 32) | words[0]);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next 32 bit random numbers of a SFMT19937
+//    state. The numbers are identical to n consecutive calls of
+//    next_random_int_sfmt
+// Variables:
+//    rng_sfmt: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_int_sfmt(rng_sfmt_type* rng_sfmt, int* randnums, size_t n){
+   while (n > 0){
+      if (rng_sfmt->idx >= SFMTSTATESIZE){
+         regenerate_sfmt(rng_sfmt->state);
+         rng_sfmt->idx = 0;
+      }
+      size_t nblock = (size_t) (SFMTSTATESIZE - rng_sfmt->idx);
+      if (nblock > n) {nblock = n;}
+
+      memcpy(randnums, rng_sfmt->state + rng_sfmt->idx, nblock*sizeof(int));
+
+      rng_sfmt->idx += (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next 64 bit random numbers of a SFMT19937
+//    state. The numbers are identical to n consecutive calls of
+//    next_random_lint_sfmt
+// Variables:
+//    rng_sfmt: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_lint_sfmt(rng_sfmt_type* rng_sfmt, long int* randnums, size_t n){
+   rng_sfmt->idx += rng_sfmt->idx & 1;
+   while (n > 0){
+      if (rng_sfmt->idx >= SFMTSTATESIZE){
+         regenerate_sfmt(rng_sfmt->state);
+         rng_sfmt->idx = 0;
+      }
+      size_t nblock = (size_t) (SFMTSTATESIZE - rng_sfmt->idx) / 2;
+      if (nblock > n) {nblock = n;}
+
+      const uint32_t* words = rng_sfmt->state + rng_sfmt->idx;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      memcpy(randnums, words, nblock*sizeof(long int));
+#else
+      for (size_t i=0; i<nblock; i++){
+         randnums[i] = (long int) (((uint64_t) words[2*i+1] << 32) | words[2*i]);
+      }
+#endif
+
+      rng_sfmt->idx += 2 * (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Makes sure the period of a dSFMT19937 state is a multiple of
+//    2^19937-1 by checking the lung
+// Variables:
+//    state: state to check and fix
+/////////////////////////////////////////////////////////////////////////////
+static void certify_period_dsfmt(uint64_t* state){
+   uint64_t inner = ((state[DSFMTN64] ^ DSFMTFIX1) & DSFMTPCV1)
+                    ^ ((state[DSFMTN64+1] ^ DSFMTFIX2) & DSFMTPCV2);
+   for (int i=32; i>0; i>>=1){
+      inner ^= inner >> i;
+   }
+   if (inner & 1u) {return;}
+   state[DSFMTN64+1] ^= 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes a dSFMT19937 uniform random number generator
+// Variables:
+//    seed: The seed
+//    lower: lower bound of random numbers
+//    upper: upper bound of random numbers
+// Return value:
+//    rng_dsfmt: dSFMT19937 random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_dsfmt_type init_rng_dsfmt(int seed, double lower, double upper){
+   rng_dsfmt_type rng_dsfmt;
+   uint32_t words[2*DSFMTSTATESIZE];
+
+   rng_dsfmt.lower = lower;
+   rng_dsfmt.upper = upper;
+   rng_dsfmt.seed = seed;
+
+   init_words32(words, 2*DSFMTSTATESIZE, (uint32_t) seed);
+   for (int i=0; i<DSFMTSTATESIZE; i++){
+      rng_dsfmt.state[i] = ((uint64_t) words[2*i+1] << 32) | words[2*i];
+   }
+   // all words except the lung are doubles in [1,2)
+   for (int i=0; i<DSFMTN64; i++){
+      rng_dsfmt.state[i] = (rng_dsfmt.state[i] & DSFMTLOWMASK) | DSFMTHIGHCONST;
+   }
+   certify_period_dsfmt(rng_dsfmt.state);
+   rng_dsfmt.idx = DSFMTN64;
+
+   return rng_dsfmt;
+}
+
+#ifdef MT_RANDOM_SSE2_KERNELS
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in a dSFMT19937 state,
+//    one 128 bit word per step
+// Variables:
+//    state: State of the generator
+/////////////////////////////////////////////////////////////////////////////
+static void regenerate_dsfmt(uint64_t* state){
+   const __m128i mask = _mm_set_epi64x((long long) DSFMTMSK2, (long long) DSFMTMSK1);
+   __m128i* w = (__m128i*) state;
+   __m128i lung = _mm_loadu_si128(w+DSFMTN);
+
+   for (int i=0; i<DSFMTN; i++){
+      int ipos = i < DSFMTN-DSFMTPOS1 ? i+DSFMTPOS1 : i+DSFMTPOS1-DSFMTN;
+      __m128i x = _mm_loadu_si128(w+i);
+      __m128i z = _mm_xor_si128(_mm_slli_epi64(x, DSFMTSL1), _mm_loadu_si128(w+ipos));
+      // swaps the 32 bit halves of both 64 bit words and the words
+      lung = _mm_xor_si128(_mm_shuffle_epi32(lung, 0x1B), z);
+      __m128i v = _mm_xor_si128(_mm_srli_epi64(lung, DSFMTSR), x);
+      _mm_storeu_si128(w+i, _mm_xor_si128(v, _mm_and_si128(lung, mask)));
+   }
+   _mm_storeu_si128(w+DSFMTN, lung);
+}
+#else
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in a dSFMT19937 state
+// Variables:
+//    state: State of the generator
+/////////////////////////////////////////////////////////////////////////////
+static void regenerate_dsfmt(uint64_t* state){
+   uint64_t lung0 = state[DSFMTN64];
+   uint64_t lung1 = state[DSFMTN64+1];
+
+   for (int i=0; i<DSFMTN; i++){
+      int ipos = i < DSFMTN-DSFMTPOS1 ? i+DSFMTPOS1 : i+DSFMTPOS1-DSFMTN;
+      uint64_t t0 = state[2*i];
+      uint64_t t1 = state[2*i+1];
+      uint64_t l0 = lung0;
+      uint64_t l1 = lung1;
+      lung0 = (t0 << DSFMTSL1) ^ (l1 >> 32) ^ (l1 << 32) ^ state[2*ipos];
+      lung1 = (t1 << DSFMTSL1) ^ (l0 >> 32) ^ (l0 << 32) ^ state[2*ipos+1];
+      state[2*i] = (lung0 >> DSFMTSR) ^ (lung0 & DSFMTMSK1) ^ t0;
+      state[2*i+1] = (lung1 >> DSFMTSR) ^ (lung1 & DSFMTMSK2) ^ t1;
+   }
+   state[DSFMTN64] = lung0;
+   state[DSFMTN64+1] = lung1;
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reinterprets a word of a dSFMT19937 state as double in [1,2)
+// Variables:
+//    word: word of the state
+// Return value:
+//    x: double in [1,2)
+/////////////////////////////////////////////////////////////////////////////
+static inline double word_double(uint64_t word){
+   union {uint64_t i; double d;} u = {word};
+   return u.d;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next uniform random number in [lower,upper) of a
+//    dSFMT19937 state
+// Variables:
+//    rng_dsfmt: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+double next_random_uniform_dsfmt(rng_dsfmt_type* rng_dsfmt){
+   if (rng_dsfmt->idx >= DSFMTN64){
+      regenerate_dsfmt(rng_dsfmt->state);
+      rng_dsfmt->idx = 0;
+   }
+   const double width = rng_dsfmt->upper - rng_dsfmt->lower;
+   // x in [1,2) to lower+(x-1)*width
+   double x = word_double(rng_dsfmt->state[rng_dsfmt->idx++]);
+   return x*width + (rng_dsfmt->lower - width);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next uniform random numbers of a dSFMT19937
+//    state. The numbers are identical to n consecutive calls of
+//    next_random_uniform_dsfmt
+// Variables:
+//    rng_dsfmt: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_uniform_dsfmt(rng_dsfmt_type* rng_dsfmt, double* randnums, size_t n){
+   const double width = rng_dsfmt->upper - rng_dsfmt->lower;
+   const double offset = rng_dsfmt->lower - width;
+
+   while (n > 0){
+      if (rng_dsfmt->idx >= DSFMTN64){
+         regenerate_dsfmt(rng_dsfmt->state);
+         rng_dsfmt->idx = 0;
+      }
+      size_t nblock = (size_t) (DSFMTN64 - rng_dsfmt->idx);
+      if (nblock > n) {nblock = n;}
+
+      // the words are doubles in [1,2) already
+      memcpy(randnums, rng_dsfmt->state + rng_dsfmt->idx, nblock*sizeof(double));
+      for (size_t i=0; i<nblock; i++){
+         randnums[i] = randnums[i]*width + offset;
+      }
+
+      rng_dsfmt->idx += (int) nblock;
+      randnums += nblock;
+      n -= nblock;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Writes the index and the 32 bit words of a state to a string
+// Variables:
+//    statestring: string to write to
+//    rngt: type character
+//    seed: The seed
+//    idx: index of the state
+//    words: words of the state
+//    nwords: number of words
+/////////////////////////////////////////////////////////////////////////////
+static void write_state_words32(char* statestring, char rngt, int seed, int idx,
+                                const uint32_t* words, int nwords){
+   sprintf(statestring, "%c %8x %8x", rngt, seed, idx);
+   statestring += 19;
+   for (int i=0; i<nwords; i++){
+      sprintf(statestring, "%9x", words[i]);
+      statestring += 9;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reads the index and the 32 bit words of a state from a string
+//    written by write_state_words32
+// Variables:
+//    statestring: string to read from
+//    seed: The seed
+//    idx: index of the state
+//    words: words of the state
+//    nwords: number of words
+/////////////////////////////////////////////////////////////////////////////
+static void read_state_words32(const char* statestring, int* seed, int* idx,
+                               uint32_t* words, int nwords){
+   sscanf(statestring+2, " %8x %8x", (unsigned int*) seed, (unsigned int*) idx);
+   statestring += 19;
+   for (int i=0; i<nwords; i++){
+      sscanf(statestring, "%9x", &words[i]);
+      statestring += 9;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Save rng state to a string
+// Variables:
+//    rng_mt32: Random number generator state
+// Return value:
+//    mt32state: that contains all the state information
+/////////////////////////////////////////////////////////////////////////////
+char* get_random_state_mt32(rng_mt32_type* rng_mt32){
+   char* mt32state = (char*)malloc(MT32_STATELENGTH*sizeof(char));
+   write_state_words32(mt32state, 'M', rng_mt32->seed, rng_mt32->mtidx,
+                       rng_mt32->mtstate, MT32STATESIZE);
+   return mt32state;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Save rng state to a string
+// Variables:
+//    rng_sfmt: Random number generator state
+// Return value:
+//    sfmtstate: that contains all the state information
+/////////////////////////////////////////////////////////////////////////////
+char* get_random_state_sfmt(rng_sfmt_type* rng_sfmt){
+   char* sfmtstate = (char*)malloc(SFMT_STATELENGTH*sizeof(char));
+   write_state_words32(sfmtstate, 'S', rng_sfmt->seed, rng_sfmt->idx,
+                       rng_sfmt->state, SFMTSTATESIZE);
+   return sfmtstate;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Save rng state to a string
+// Variables:
+//    rng_dsfmt: Random number generator state
+// Return value:
+//    dsfmtstate: that contains all the state information
+/////////////////////////////////////////////////////////////////////////////
+char* get_random_state_dsfmt(rng_dsfmt_type* rng_dsfmt){
+   char* dsfmtstate = (char*)malloc(DSFMT_STATELENGTH*sizeof(char));
+   char* tmpchar = dsfmtstate;
+   void* v;
+
+   v = &rng_dsfmt->lower;
+   sprintf(tmpchar, "D%17lx", *((unsigned long int*)v));
+   tmpchar += 18;
+   v = &rng_dsfmt->upper;
+   sprintf(tmpchar, "%17lx", *((unsigned long int*)v));
+   tmpchar += 17;
+   sprintf(tmpchar, " %8x %8x", rng_dsfmt->seed, rng_dsfmt->idx);
+   tmpchar += 18;
+   for (int i=0; i<DSFMTSTATESIZE; i++){
+      sprintf(tmpchar, "%17lx", rng_dsfmt->state[i]);
+      tmpchar += 17;
+   }
+
+   return dsfmtstate;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a string
+// Variables:
+//    mt32state: string that contains all the state information
+// Return value:
+//    rng_mt32: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+rng_mt32_type restore_rng_state_mt32(char* mt32state){
+   rng_mt32_type rng_mt32;
+   check_state_type(mt32state, 'M', "MT19937");
+   read_state_words32(mt32state, &rng_mt32.seed, &rng_mt32.mtidx,
+                      rng_mt32.mtstate, MT32STATESIZE);
+   return rng_mt32;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a string
+// Variables:
+//    sfmtstate: string that contains all the state information
+// Return value:
+//    rng_sfmt: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+rng_sfmt_type restore_rng_state_sfmt(char* sfmtstate){
+   rng_sfmt_type rng_sfmt;
+   check_state_type(sfmtstate, 'S', "SFMT19937");
+   read_state_words32(sfmtstate, &rng_sfmt.seed, &rng_sfmt.idx,
+                      rng_sfmt.state, SFMTSTATESIZE);
+   return rng_sfmt;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a string
+// Variables:
+//    dsfmtstate: string that contains all the state information
+// Return value:
+//    rng_dsfmt: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+rng_dsfmt_type restore_rng_state_dsfmt(char* dsfmtstate){
+   rng_dsfmt_type rng_dsfmt;
+   check_state_type(dsfmtstate, 'D', "dSFMT19937");
+
+   dsfmtstate += 1;
+   sscanf(dsfmtstate, "%17lx", (unsigned long int*)(void*)&rng_dsfmt.lower);
+   dsfmtstate += 17;
+   sscanf(dsfmtstate, "%17lx", (unsigned long int*)(void*)&rng_dsfmt.upper);
+   dsfmtstate += 17;
+   sscanf(dsfmtstate, " %8x %8x", (unsigned int*) &rng_dsfmt.seed, (unsigned int*) &rng_dsfmt.idx);
+   dsfmtstate += 18;
+   for (int i=0; i<DSFMTSTATESIZE; i++){
+      sscanf(dsfmtstate, "%17lx", (unsigned long int*) &rng_dsfmt.state[i]);
+      dsfmtstate += 17;
+   }
+
+   return rng_dsfmt;
+}
@@ -0,0 +1,305 @@
+#ifndef MT_RANDOM_ENGINES_H
+#define MT_RANDOM_ENGINES_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains further members of the mersenne twister family with the
+   //    same kind of interface as the MT19937-64 states of MT_random.h:
+   //    MT19937: classic 32 bit mersenne twister (Matsumoto and Nishimura
+   //             1998), identical to init_genrand/genrand_int32 of mt19937ar
+   //    SFMT19937: SIMD oriented fast mersenne twister (Saito and Matsumoto
+   //               2008) for 32 and 64 bit numbers, identical to
+   //               gen_rand32/gen_rand64 of SFMT 1.5
+   //    dSFMT19937: double precision SFMT (Saito and Matsumoto 2009), whose
+   //                state holds doubles in [1,2) directly, identical to
+   //                dsfmt_genrand_close1_open2 of dSFMT 2.2 before scaling
+   //    The SFMT kernels use SSE2 if the compiler targets it, the results
+   //    do not depend on it.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_engines.h"
+   //    Initialize the random number state:
+   //       rng_statem = init_rng_mt32(seed)
+   //       rng_states = init_rng_sfmt(seed)
+   //       rng_stated = init_rng_dsfmt(seed, lowerbound, upperbound)
+   //    Get the next random number:
+   //       random_number = next_random_int_mt32(&rng_statem) ;
+   //       random_number = next_random_int_sfmt(&rng_states) ;
+   //       random_number = next_random_lint_sfmt(&rng_states) ;
+   //       random_number = next_random_uniform_dsfmt(&rng_stated) ;
+   //    Fill an array with the next n random numbers:
+   //       fill_random_int_mt32(&rng_statem, random_numbers, n) ;
+   //       fill_random_int_sfmt(&rng_states, random_numbers, n) ;
+   //       fill_random_lint_sfmt(&rng_states, random_numbers, n) ;
+   //       fill_random_uniform_dsfmt(&rng_stated, random_numbers, n) ;
+   //    Store the state in a string for writeout:
+   //       rng_state_string = get_random_state_mt32(&rng_statem) ;
+   //       rng_state_string = get_random_state_sfmt(&rng_states) ;
+   //       rng_state_string = get_random_state_dsfmt(&rng_stated) ;
+   //    Restore a previously extracted state:
+   //       rng_statem = restore_rng_state_mt32(rng_state_string) ;
+   //       rng_states = restore_rng_state_sfmt(rng_state_string) ;
+   //       rng_stated = restore_rng_state_dsfmt(rng_state_string) ;
+   //    There is no need for freeing anything except the state string pointer
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include <stdint.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   // number of 32 bit words of the MT19937 state
+   #define MT32STATESIZE 624
+   // number of 32 bit words of the SFMT19937 state
+   #define SFMTSTATESIZE 624
+   // number of 64 bit words of the dSFMT19937 state including the lung
+   #define DSFMTSTATESIZE 384
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of a 32 bit MT19937 random number generator
+   // Variables:
+   //    seed: The seed
+   //    mtidx: index of the current random number of current state
+   //    mtstate: State of the mersenne twister
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_mt32_s {
+      int seed ;
+      int mtidx ;
+      uint32_t mtstate[MT32STATESIZE] ;
+   } rng_mt32_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of a SFMT19937 random number generator
+   // Variables:
+   //    seed: The seed
+   //    idx: index of the next unused 32 bit word of the state
+   //    state: 156 128 bit words as 32 bit words, lowest first
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_sfmt_s {
+      int seed ;
+      int idx ;
+      uint32_t state[SFMTSTATESIZE] ;
+   } rng_sfmt_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of a dSFMT19937 uniform random number generator
+   // Variables:
+   //    lower: lower bound of random numbers
+   //    upper: upper bound of random numbers
+   //    seed: The seed
+   //    idx: index of the next unused double of the state
+   //    state: 191 128 bit words and the lung as 64 bit words, lowest first
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_dsfmt_s {
+      double lower ;
+      double upper ;
+      int seed ;
+      int idx ;
+      uint64_t state[DSFMTSTATESIZE] ;
+   } rng_dsfmt_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a 32 bit MT19937 random number generator
+   // Variables:
+   //    seed: The seed
+   // Return value:
+   //    rng_mt32: MT19937 random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_mt32_type init_rng_mt32(int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a 32 bit MT19937 random number generator in place from
+   //    an array of 32 bit keys (init_by_array of mt19937ar). The seed member
+   //    holds the first key.
+   // Variables:
+   //    rng_mt32: MT19937 random number state to initialize
+   //    key: array of keys
+   //    keylength: number of keys, has to be positive
+   /////////////////////////////////////////////////////////////////////////////
+   void init_rng_mt32_by_array(rng_mt32_type* rng_mt32, const uint32_t* key, size_t keylength);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a SFMT19937 random number generator
+   // Variables:
+   //    seed: The seed
+   // Return value:
+   //    rng_sfmt: SFMT19937 random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_sfmt_type init_rng_sfmt(int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes a dSFMT19937 uniform random number generator
+   // Variables:
+   //    seed: The seed
+   //    lower: lower bound of random numbers
+   //    upper: upper bound of random numbers
+   // Return value:
+   //    rng_dsfmt: dSFMT19937 random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_dsfmt_type init_rng_dsfmt(int seed, double lower, double upper);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next 32 bit random number of a MT19937 state
+   // Variables:
+   //    rng_mt32: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   int next_random_int_mt32(rng_mt32_type* rng_mt32);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next 32 bit random number of a SFMT19937 state
+   // Variables:
+   //    rng_sfmt: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   int next_random_int_sfmt(rng_sfmt_type* rng_sfmt);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next 64 bit random number of a SFMT19937 state from
+   //    two consecutive 32 bit words. After an odd number of 32 bit numbers
+   //    one word is skipped.
+   // Variables:
+   //    rng_sfmt: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   long int next_random_lint_sfmt(rng_sfmt_type* rng_sfmt);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next uniform random number in [lower,upper) of a
+   //    dSFMT19937 state
+   // Variables:
+   //    rng_dsfmt: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   double next_random_uniform_dsfmt(rng_dsfmt_type* rng_dsfmt);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next 32 bit random numbers of a MT19937 state
+   //    The numbers are identical to n consecutive calls of
+   //    next_random_int_mt32
+   // Variables:
+   //    rng_mt32: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_int_mt32(rng_mt32_type* rng_mt32, int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next 32 bit random numbers of a SFMT19937
+   //    state. The numbers are identical to n consecutive calls of
+   //    next_random_int_sfmt
+   // Variables:
+   //    rng_sfmt: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_int_sfmt(rng_sfmt_type* rng_sfmt, int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next 64 bit random numbers of a SFMT19937
+   //    state. The numbers are identical to n consecutive calls of
+   //    next_random_lint_sfmt
+   // Variables:
+   //    rng_sfmt: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_lint_sfmt(rng_sfmt_type* rng_sfmt, long int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next uniform random numbers of a dSFMT19937
+   //    state. The numbers are identical to n consecutive calls of
+   //    next_random_uniform_dsfmt
+   // Variables:
+   //    rng_dsfmt: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_uniform_dsfmt(rng_dsfmt_type* rng_dsfmt, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Save rng state to a string
+   // Variables:
+   //    rng_mt32: Random number generator state
+   // Return value:
+   //    mt32state: that contains all the state information
+   /////////////////////////////////////////////////////////////////////////////
+   char* get_random_state_mt32(rng_mt32_type* rng_mt32);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Save rng state to a string
+   // Variables:
+   //    rng_sfmt: Random number generator state
+   // Return value:
+   //    sfmtstate: that contains all the state information
+   /////////////////////////////////////////////////////////////////////////////
+   char* get_random_state_sfmt(rng_sfmt_type* rng_sfmt);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Save rng state to a string
+   // Variables:
+   //    rng_dsfmt: Random number generator state
+   // Return value:
+   //    dsfmtstate: that contains all the state information
+   /////////////////////////////////////////////////////////////////////////////
+   char* get_random_state_dsfmt(rng_dsfmt_type* rng_dsfmt);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a string
+   // Variables:
+   //    mt32state: string that contains all the state information
+   // Return value:
+   //    rng_mt32: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_mt32_type restore_rng_state_mt32(char* mt32state);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a string
+   // Variables:
+   //    sfmtstate: string that contains all the state information
+   // Return value:
+   //    rng_sfmt: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_sfmt_type restore_rng_state_sfmt(char* sfmtstate);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a string
+   // Variables:
+   //    dsfmtstate: string that contains all the state information
+   // Return value:
+   //    rng_dsfmt: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_dsfmt_type restore_rng_state_dsfmt(char* dsfmtstate);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
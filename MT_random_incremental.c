@@ -0,0 +1,113 @@
+#include <string.h>
+#include "MT_random.h"
+#include "MT_random_internal.h"
+#include "MT_random_incremental.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Replaces a number of a ring buffer of NN consecutive numbers of the
+//    sequence by the number NN positions further. The numbers following
+//    it in the ring buffer still have to be the ones of the sequence.
+// Variables:
+//    mtstate: ring buffer
+//    i: position of the number to replace
+/////////////////////////////////////////////////////////////////////////////
+static inline void twist_ring_element(long int* mtstate, int i){
+   int ip1 = i+1 < NN ? i+1 : i+1-NN;
+   int ipm = i+MM < NN ? i+MM : i+MM-NN;
+   unsigned long int rng = (mtstate[i] & UM) ^ (mtstate[ip1] & LM);
+   mtstate[i] = (mtstate[ipm] ^ (rng>>1)) ^ (mag[(rng& 1)]) ;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Converts an int random number state to an incremental one that
+//    continues the same sequence. The used numbers of the current state
+//    are replaced one by one in the order of the sequence.
+// Variables:
+//    rng_int: int random number state
+// Return value:
+//    rng_int_incremental: incremental int random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_int_incremental_type rng_int_to_incremental(const rng_int_type* rng_int){
+   rng_int_incremental_type rng_int_incremental;
+
+   rng_int_incremental.seed = rng_int->seed;
+   memcpy(rng_int_incremental.mtstate, rng_int->mtstate, sizeof(rng_int->mtstate));
+   int mtidx = rng_int->mtidx;
+   if (mtidx > NN-2){
+      regenerate_mtstate(rng_int_incremental.mtstate);
+      mtidx = -1;
+   }
+
+   for (int i=0; i<=mtidx; i++){
+      twist_ring_element(rng_int_incremental.mtstate, i);
+   }
+   rng_int_incremental.mtidx = mtidx+1 < NN ? mtidx+1 : 0;
+   return rng_int_incremental;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Converts an incremental int random number state to an ordinary one
+//    that continues the same sequence. The ring buffer is rotated to
+//    start at the next number.
+// Variables:
+//    rng_int_incremental: incremental int random number state
+// Return value:
+//    rng_int: int random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_int_type rng_int_from_incremental(const rng_int_incremental_type* rng_int_incremental){
+   rng_int_type rng_int;
+   int start = rng_int_incremental->mtidx;
+
+   rng_int.seed = rng_int_incremental->seed;
+   memcpy(rng_int.mtstate, rng_int_incremental->mtstate+start, (NN-start)*sizeof(long int));
+   memcpy(rng_int.mtstate+NN-start, rng_int_incremental->mtstate, start*sizeof(long int));
+   rng_int.mtidx = -1;
+   reset_instrument(&rng_int);
+   return rng_int;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes an incremental int random number generator
+// Variables:
+//    seed: The seed
+// Return value:
+//    rng_int_incremental: incremental int random number state
+/////////////////////////////////////////////////////////////////////////////
+rng_int_incremental_type init_rng_int_incremental(int seed){
+   rng_int_type rng_int;
+   init_rng_int_inplace(&rng_int, seed);
+   return rng_int_to_incremental(&rng_int);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next long int random number
+// Variables:
+//    rng_int_incremental: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+long int next_random_lint_incremental(rng_int_incremental_type* rng_int_incremental){
+   int i = rng_int_incremental->mtidx;
+   unsigned long int rng = temper_rng_int(rng_int_incremental->mtstate[i]);
+
+   twist_ring_element(rng_int_incremental->mtstate, i);
+   rng_int_incremental->mtidx = i+1 < NN ? i+1 : 0;
+   return (long int) rng;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next int random number
+// Variables:
+//    rng_int_incremental: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+int next_random_int_incremental(rng_int_incremental_type* rng_int_incremental){
+   return (int) ((unsigned long int)next_random_lint_incremental(rng_int_incremental)>>32);
+}
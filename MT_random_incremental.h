@@ -0,0 +1,104 @@
+#ifndef MT_RANDOM_INCREMENTAL_H
+#define MT_RANDOM_INCREMENTAL_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to generate int random numbers with an evenly
+   //    spread cost. Instead of regenerating the whole mersenne twister state
+   //    after MTSTATESIZE numbers, every call computes the one number that
+   //    replaces the number it returns. The sequence is identical to the one
+   //    of next_random_lint, but no single call is slower than the others.
+   //    The bulk routines of MT_random.h are faster on average, so this
+   //    state is meant for latency sensitive code.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_incremental.h"
+   //    Initialize the state:
+   //       rng_statec = init_rng_int_incremental(seed)
+   //    Get the next random number:
+   //       Int:
+   //          random_number = next_random_int_incremental(&rng_statec) ;
+   //       Long int:
+   //          random_number = next_random_lint_incremental(&rng_statec) ;
+   //    Convert from and to an int random number state at the same position:
+   //       rng_statec = rng_int_to_incremental(&rng_statei)
+   //       rng_statei = rng_int_from_incremental(&rng_statec)
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the state of an incremental int random number generator
+   // Variables:
+   //    seed: The seed
+   //    mtidx: position of the next random number in mtstate
+   //    mtstate: the next MTSTATESIZE numbers of the sequence as ring buffer
+   //             starting at mtidx
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_int_incremental_s {
+      int seed ;
+      int mtidx ;
+      long int mtstate[MTSTATESIZE] ;
+   } rng_int_incremental_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes an incremental int random number generator
+   // Variables:
+   //    seed: The seed
+   // Return value:
+   //    rng_int_incremental: incremental int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_int_incremental_type init_rng_int_incremental(int seed);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next long int random number
+   // Variables:
+   //    rng_int_incremental: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   long int next_random_lint_incremental(rng_int_incremental_type* rng_int_incremental);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next int random number
+   // Variables:
+   //    rng_int_incremental: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   int next_random_int_incremental(rng_int_incremental_type* rng_int_incremental);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Converts an int random number state to an incremental one that
+   //    continues the same sequence
+   // Variables:
+   //    rng_int: int random number state
+   // Return value:
+   //    rng_int_incremental: incremental int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_int_incremental_type rng_int_to_incremental(const rng_int_type* rng_int);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Converts an incremental int random number state to an ordinary one
+   //    that continues the same sequence
+   // Variables:
+   //    rng_int_incremental: incremental int random number state
+   // Return value:
+   //    rng_int: int random number state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_int_type rng_int_from_incremental(const rng_int_incremental_type* rng_int_incremental);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
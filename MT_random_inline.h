@@ -0,0 +1,104 @@
+#ifndef MT_RANDOM_INLINE_H
+#define MT_RANDOM_INLINE_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Inlineable versions of the single number routines. The index check,
+   //    the tempering and the conversion are compiled into the caller, only
+   //    the regeneration of the state is a function call. The numbers are
+   //    identical to the ones of the out of line routines and both can be
+   //    mixed on the same state.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_inline.h"
+   //    Get the next random number:
+   //       Long int:
+   //          random_number = next_random_lint_inline(&rng_statei) ;
+   //       Int:
+   //          random_number = next_random_int_inline(&rng_statei) ;
+   //       Uniform:
+   //          random_number = next_random_uniform_inline(&rng_stateu) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Creates a new set of random numbers in the mersenne twister state
+   //    and resets the index
+   // Variables:
+   //    rng_int: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   void regenerate_rng_int(rng_int_type* rng_int);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Mixes up a number from the mersenne twister state
+   // Variables:
+   //    rng: Element of the mersenne twister state
+   // Return value:
+   //    rng: tempered random number
+   /////////////////////////////////////////////////////////////////////////////
+   static inline unsigned long int temper_rng_int(unsigned long int rng){
+      rng = (rng) ^ ((rng>>29) & 0x5555555555555555) ;
+      rng = (rng) ^ ((rng<<17) & 0x71d67fffeda60000) ;
+      rng = (rng) ^ ((rng<<37) & 0xfff7eee000000000) ;
+      rng = (rng) ^  (rng>>43) ;
+      return rng;
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next long int random number,
+   //    identical to next_random_lint
+   // Variables:
+   //    rng_int: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   static inline long int next_random_lint_inline(rng_int_type* rng_int){
+      if (__builtin_expect(rng_int->mtidx > MTSTATESIZE-2, 0)){
+         regenerate_rng_int(rng_int);
+      }
+      rng_int->mtidx += 1 ;
+      return (long int) temper_rng_int(rng_int->mtstate[rng_int->mtidx]);
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next int random number,
+   //    identical to next_random_int
+   // Variables:
+   //    rng_int: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   static inline int next_random_int_inline(rng_int_type* rng_int){
+      return (int) ((unsigned long int)next_random_lint_inline(rng_int)>>32);
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next uniform random number,
+   //    identical to next_random_uniform
+   // Variables:
+   //    rng_uniform: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   static inline double next_random_uniform_inline(rng_uniform_type* rng_uniform){
+      unsigned long int irng = next_random_lint_inline(&rng_uniform->rng_int);
+      double randnum = (1.0/((double)0x001FFFFFFFFFFFFF)) * (double)(irng>>11);
+      randnum *= rng_uniform->upper - rng_uniform->lower;
+      randnum += rng_uniform->lower;
+      return randnum;
+   }
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
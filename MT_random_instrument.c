@@ -0,0 +1,124 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "MT_random.h"
+#include "MT_random_internal.h"
+#include "MT_random_instrument.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Tells whether the library was compiled with the counters
+// Return value:
+//    enabled: true with -DMT_RANDOM_INSTRUMENT
+/////////////////////////////////////////////////////////////////////////////
+bool rng_instrument_enabled(void){
+#ifdef MT_RANDOM_INSTRUMENT
+   return true;
+#else
+   return false;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Tells whether the library was compiled with the cycle counters
+// Return value:
+//    enabled: true with -DMT_RANDOM_INSTRUMENT_CYCLES in addition
+/////////////////////////////////////////////////////////////////////////////
+bool rng_instrument_cycles_enabled(void){
+#if defined(MT_RANDOM_INSTRUMENT) && defined(MT_RANDOM_INSTRUMENT_CYCLES)
+   return true;
+#else
+   return false;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Takes a snapshot of the counters of an int random number state
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    counters: counters of the state
+/////////////////////////////////////////////////////////////////////////////
+rng_counters_type get_rng_counters_int(const rng_int_type* rng_int){
+   rng_counters_type counters = {0};
+#ifdef MT_RANDOM_INSTRUMENT
+   counters.position = get_instrument_position(rng_int);
+   counters.ntwists = rng_int->instrument.ntwists;
+   counters.twistcycles = rng_int->instrument.twistcycles;
+   counters.ntransforms = rng_int->instrument.ntransforms;
+   counters.transformcycles = rng_int->instrument.transformcycles;
+#else
+   (void) rng_int;
+#endif
+   return counters;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Takes a snapshot of the counters of a uniform random number state
+// Variables:
+//    rng_uniform: Random number generator state
+// Return value:
+//    counters: counters of the state
+/////////////////////////////////////////////////////////////////////////////
+rng_counters_type get_rng_counters_uniform(const rng_uniform_type* rng_uniform){
+   return get_rng_counters_int(&rng_uniform->rng_int);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Takes a snapshot of the counters of a gaussian random number state
+// Variables:
+//    rng_gaussian: Random number generator state
+// Return value:
+//    counters: counters of the state
+/////////////////////////////////////////////////////////////////////////////
+rng_counters_type get_rng_counters_gaussian(const rng_gaussian_type* rng_gaussian){
+   return get_rng_counters_uniform(&rng_gaussian->rng_uniform);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Gives the number of random numbers drawn or skipped from a state
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    position: position of the state
+/////////////////////////////////////////////////////////////////////////////
+uint64_t get_rng_position_int(const rng_int_type* rng_int){
+   return get_instrument_position(rng_int);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Adds the counters of one stream to a total
+// Variables:
+//    total: aggregated counters
+//    counters: counters to add
+/////////////////////////////////////////////////////////////////////////////
+void add_rng_counters(rng_counters_type* total, const rng_counters_type* counters){
+   total->position += counters->position;
+   total->ntwists += counters->ntwists;
+   total->twistcycles += counters->twistcycles;
+   total->ntransforms += counters->ntransforms;
+   total->transformcycles += counters->transformcycles;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Clears the counters of an int random number state. The twists are
+//    moved into the offset, so the position stays the same.
+// Variables:
+//    rng_int: Random number generator state
+/////////////////////////////////////////////////////////////////////////////
+void reset_rng_counters_int(rng_int_type* rng_int){
+#ifdef MT_RANDOM_INSTRUMENT
+   uint64_t position = get_instrument_position(rng_int);
+   rng_instrument_type instrument = {0};
+   rng_int->instrument = instrument;
+   set_instrument_position(rng_int, position);
+#else
+   (void) rng_int;
+#endif
+}
@@ -0,0 +1,139 @@
+#ifndef MT_RANDOM_INSTRUMENT_H
+#define MT_RANDOM_INSTRUMENT_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to read the counters of instrumented random number
+   //    states. The counters are only compiled in with -DMT_RANDOM_INSTRUMENT,
+   //    the cycle counters around the regeneration of the state and the
+   //    Box-Muller transform of next_random_gaussian and fill_random_gaussian
+   //    with -DMT_RANDOM_INSTRUMENT_CYCLES in addition (rdtsc on x86,
+   //    nanoseconds elsewhere). Without the flags the states have their usual
+   //    size and speed and all counters read as zero. The library and all
+   //    code that uses the states have to be compiled with the same flags.
+   //    The position counts the numbers drawn or skipped with discard since
+   //    the state was initialized, restored or extracted, jumps with a jump
+   //    polynomial leave it unchanged.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_instrument.h"
+   //    Check whether the counters are compiled in:
+   //       enabled = rng_instrument_enabled() ;
+   //    Take a snapshot of the counters of a state:
+   //       counters = get_rng_counters_int(&rng_statei) ;
+   //       counters = get_rng_counters_uniform(&rng_stateu) ;
+   //       counters = get_rng_counters_gaussian(&rng_stateg) ;
+   //    Get the position of a state:
+   //       position = get_rng_position_int(&rng_statei) ;
+   //    Aggregate the counters of several streams:
+   //       add_rng_counters(&total, &counters) ;
+   //    Clear the counters of a state, the position is kept:
+   //       reset_rng_counters_int(&rng_statei) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stdbool.h>
+   #include <stdint.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold a snapshot of the counters of one or more states
+   // Variables:
+   //    position: number of random numbers drawn or skipped
+   //    ntwists: number of regenerations of the mersenne twister state
+   //    twistcycles: cycles spent in the regenerations
+   //    ntransforms: number of Box-Muller transforms
+   //    transformcycles: cycles spent in the Box-Muller transforms
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_counters_s {
+      uint64_t position ;
+      uint64_t ntwists ;
+      uint64_t twistcycles ;
+      uint64_t ntransforms ;
+      uint64_t transformcycles ;
+   } rng_counters_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Tells whether the library was compiled with the counters
+   // Return value:
+   //    enabled: true with -DMT_RANDOM_INSTRUMENT
+   /////////////////////////////////////////////////////////////////////////////
+   bool rng_instrument_enabled(void);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Tells whether the library was compiled with the cycle counters
+   // Return value:
+   //    enabled: true with -DMT_RANDOM_INSTRUMENT_CYCLES in addition
+   /////////////////////////////////////////////////////////////////////////////
+   bool rng_instrument_cycles_enabled(void);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Takes a snapshot of the counters of an int random number state
+   // Variables:
+   //    rng_int: Random number generator state
+   // Return value:
+   //    counters: counters of the state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_counters_type get_rng_counters_int(const rng_int_type* rng_int);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Takes a snapshot of the counters of a uniform random number state
+   // Variables:
+   //    rng_uniform: Random number generator state
+   // Return value:
+   //    counters: counters of the state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_counters_type get_rng_counters_uniform(const rng_uniform_type* rng_uniform);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Takes a snapshot of the counters of a gaussian random number state
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   // Return value:
+   //    counters: counters of the state
+   /////////////////////////////////////////////////////////////////////////////
+   rng_counters_type get_rng_counters_gaussian(const rng_gaussian_type* rng_gaussian);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Gives the number of random numbers drawn or skipped from a state,
+   //    the number of regenerations times MTSTATESIZE plus the numbers used
+   //    of the current state
+   // Variables:
+   //    rng_int: Random number generator state
+   // Return value:
+   //    position: position of the state
+   /////////////////////////////////////////////////////////////////////////////
+   uint64_t get_rng_position_int(const rng_int_type* rng_int);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Adds the counters of one stream to a total
+   // Variables:
+   //    total: aggregated counters, start from a zero initialized snapshot
+   //    counters: counters to add
+   /////////////////////////////////////////////////////////////////////////////
+   void add_rng_counters(rng_counters_type* total, const rng_counters_type* counters);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Clears the counters of an int random number state, except for the
+   //    position
+   // Variables:
+   //    rng_int: Random number generator state
+   /////////////////////////////////////////////////////////////////////////////
+   void reset_rng_counters_int(rng_int_type* rng_int);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef MT_RANDOM_INTERNAL_H
+#define MT_RANDOM_INTERNAL_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Definitions shared between the source files of the library.
+   //    This header is not part of the public interface.
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include <stdint.h>
+   #include "MT_random.h"
+   #include "MT_random_inline.h"
+
+   #define NN (MTSTATESIZE)
+   #define MM 0x000000000000009C
+   #define UM 0xFFFFFFFF80000000
+   #define LM 0x000000007FFFFFFF
+
+   // length of the string of get_random_state_int
+   #define INT_STATELENGTH (1+2*9+312*17+1)
+
+   extern const long int mag[2] ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Creates a new set of random numbers in a mersenne twister state.
+   //    Uses the fastest kernel the cpu supports.
+   // Variables:
+   //    mtstate: State of the mersenne twister
+   /////////////////////////////////////////////////////////////////////////////
+   void regenerate_mtstate(long int* mtstate);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Creates a new set of random numbers in nlanes interleaved mersenne
+   //    twister states. Uses the fastest kernel the cpu supports.
+   // Variables:
+   //    mtstate: interleaved states, element i of lane l at i*nlanes+l
+   //    nlanes: number of interleaved states
+   /////////////////////////////////////////////////////////////////////////////
+   void regenerate_mtstate_lanes(long int* mtstate, int nlanes);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Tempers a consecutive part of a mersenne twister state.
+   //    Uses the fastest kernel the cpu supports.
+   // Variables:
+   //    mtstate: first element of the state to temper
+   //    randnums: array to hold the random numbers
+   //    n: number of elements to temper
+   /////////////////////////////////////////////////////////////////////////////
+   void temper_mtstate(const long int* mtstate, long int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Performs the Box-Muller transform on pairs of uniform random numbers
+   //    with polynomial approximations of log, sin and cos.
+   //    Uses the fastest kernel the cpu supports, all kernels give identical
+   //    results. Pairs with u1 == 0 give meaningless results.
+   // Variables:
+   //    uniforms: npairs pairs (u1, u2) with u1 in (0,1] and u2 in [0,1]
+   //    gaussians: array to hold npairs pairs (z1, z2)
+   //    npairs: number of pairs
+   /////////////////////////////////////////////////////////////////////////////
+   void box_muller_pairs(const double* uniforms, double* gaussians, size_t npairs);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Tempers a consecutive part of a mersenne twister state and converts
+   //    it to doubles x*scale+offset. x in [1,2) holds the upper 52 bits of
+   //    a number as mantissa. Uses the fastest kernel the cpu supports.
+   // Variables:
+   //    mtstate: first element of the state to convert
+   //    randnums: array to hold the random numbers
+   //    n: number of elements to convert
+   //    onebits: exponent bits of 1.0, optionally with the lowest mantissa bit
+   //    scale: factor of x
+   //    offset: summand of x*scale
+   /////////////////////////////////////////////////////////////////////////////
+   void uniform_mtstate(const long int* mtstate, double* randnums, size_t n,
+                        unsigned long int onebits, double scale, double offset);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates a standard normal random number with the ziggurat algorithm
+   // Variables:
+   //    rng_int: Random number generator state
+   // Return value:
+   //    randnum: standard normal random number
+   /////////////////////////////////////////////////////////////////////////////
+   double standard_normal_ziggurat(rng_int_type* rng_int);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates a standard exponential random number with the ziggurat
+   //    algorithm
+   // Variables:
+   //    rng_int: Random number generator state
+   // Return value:
+   //    randnum: standard exponential random number
+   /////////////////////////////////////////////////////////////////////////////
+   double standard_exponential_ziggurat(rng_int_type* rng_int);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with standard exponential random numbers of the
+   //    ziggurat algorithm, identical to n consecutive single calls
+   // Variables:
+   //    rng_int: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_standard_exponential_ziggurat(rng_int_type* rng_int, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Hooks of the instrumentation layer. Without -DMT_RANDOM_INSTRUMENT
+   //    they are empty and vanish from the callers, the cycle counter is
+   //    only read with -DMT_RANDOM_INSTRUMENT_CYCLES in addition.
+   /////////////////////////////////////////////////////////////////////////////
+   #if defined(MT_RANDOM_INSTRUMENT) && defined(MT_RANDOM_INSTRUMENT_CYCLES)
+      #if defined(__x86_64__) || defined(__i386__)
+         #include <x86intrin.h>
+         static inline uint64_t read_instrument_cycles(void){
+            return (uint64_t) __rdtsc();
+         }
+      #else
+         #include <time.h>
+         // nanoseconds stand in for cycles
+         static inline uint64_t read_instrument_cycles(void){
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return (uint64_t) now.tv_sec*1000000000ul + (uint64_t) now.tv_nsec;
+         }
+      #endif
+   #else
+      static inline uint64_t read_instrument_cycles(void){
+         return 0;
+      }
+   #endif
+
+   #ifdef MT_RANDOM_INSTRUMENT
+      /////////////////////////////////////////////////////////////////////////////
+      // Description:
+      //    Number of random numbers taken from the current mersenne twister
+      //    state, an exhausted state counts as fully used
+      /////////////////////////////////////////////////////////////////////////////
+      static inline uint64_t used_rng_int(const rng_int_type* rng_int){
+         return rng_int->mtidx < NN-1 ? (uint64_t) (rng_int->mtidx+1) : NN;
+      }
+
+      static inline uint64_t get_instrument_position(const rng_int_type* rng_int){
+         return rng_int->instrument.ntwists*NN + used_rng_int(rng_int)
+                + rng_int->instrument.offset;
+      }
+
+      static inline void set_instrument_position(rng_int_type* rng_int, uint64_t position){
+         rng_int->instrument.offset = position - rng_int->instrument.ntwists*NN
+                                      - used_rng_int(rng_int);
+      }
+
+      static inline void reset_instrument(rng_int_type* rng_int){
+         rng_instrument_type instrument = {0};
+         rng_int->instrument = instrument;
+         set_instrument_position(rng_int, 0);
+      }
+
+      static inline void count_instrument_twist(rng_int_type* rng_int, uint64_t start){
+         rng_int->instrument.ntwists++;
+         rng_int->instrument.twistcycles += read_instrument_cycles() - start;
+      }
+
+      static inline void count_instrument_transform(rng_int_type* rng_int, uint64_t start){
+         rng_int->instrument.ntransforms++;
+         rng_int->instrument.transformcycles += read_instrument_cycles() - start;
+      }
+   #else
+      static inline uint64_t get_instrument_position(const rng_int_type* rng_int){
+         (void) rng_int;
+         return 0;
+      }
+      static inline void set_instrument_position(rng_int_type* rng_int, uint64_t position){
+         (void) rng_int; (void) position;
+      }
+      static inline void reset_instrument(rng_int_type* rng_int){
+         (void) rng_int;
+      }
+      static inline void count_instrument_twist(rng_int_type* rng_int, uint64_t start){
+         (void) rng_int; (void) start;
+      }
+      static inline void count_instrument_transform(rng_int_type* rng_int, uint64_t start){
+         (void) rng_int; (void) start;
+      }
+   #endif
+
+#endif
@@ -0,0 +1,503 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "MT_random.h"
+#include "MT_random_internal.h"
+#include "MT_random_jump.h"
+
+// degree of the characteristic polynomial (period 2^19937-1)
+#define MEXP 19937
+// number of sequence bits for the Berlekamp-Massey algorithm (>= 2*MEXP)
+#define BMLENGTH (128*NN)
+#define BMSIZE (BMLENGTH/64+3)
+// words for polynomials of degree <= MEXP and for their squares
+#define PSIZE (MEXP/64+1)
+#define SQSIZE (2*PSIZE+2)
+// words of a square eliminated at once, their bits have to move below
+// themselves by the gap between the two highest powers of the
+// characteristic polynomial
+#define REDUCEWORDS 4
+#if (2*JUMPPOLYSIZE-MEXP/64-1) % REDUCEWORDS != 0
+   #error "The squares have to fill whole blocks of REDUCEWORDS words"
+#endif
+
+// below this distance skipping numbers is cheaper than a jump
+#define DISCARD_JUMPTHRESHOLD (1ul<<27)
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Extracts 64 consecutive bits from a bit array
+// Variables:
+//    bits: bit array
+//    pos: position of the first bit
+// Return value:
+//    word: bits pos to pos+63
+/////////////////////////////////////////////////////////////////////////////
+static inline unsigned long int extract_bits(const unsigned long int* bits, size_t pos){
+   size_t iw = pos/64;
+   unsigned int ib = pos%64;
+   if (ib == 0) {return bits[iw];}
+   return (bits[iw] >> ib) | (bits[iw+1] << (64-ib));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Adds a polynomial multiplied by x^shift to another polynomial
+// Variables:
+//    poly: polynomial to add to
+//    npoly: number of words of poly
+//    addpoly: polynomial to add
+//    naddpoly: number of nonzero words of addpoly
+//    shift: power of x to multiply addpoly with
+/////////////////////////////////////////////////////////////////////////////
+static void add_shifted_poly(unsigned long int* poly, size_t npoly,
+                             const unsigned long int* addpoly, size_t naddpoly,
+                             size_t shift){
+   size_t iw = shift/64;
+   unsigned int ib = shift%64;
+   for (size_t i=0; i<naddpoly && i+iw<npoly; i++){
+      poly[i+iw] ^= addpoly[i] << ib;
+      if (ib != 0 && i+iw+1 < npoly) {
+         poly[i+iw+1] ^= addpoly[i] >> (64-ib);
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Determines the characteristic polynomial of the mersenne twister
+//    with the Berlekamp-Massey algorithm applied to the lowest bit of
+//    the generated numbers. As the polynomial is irreducible the minimal
+//    polynomial of any such sequence is the characteristic polynomial.
+// Variables:
+//    charpoly: PSIZE words to hold the polynomial of degree MEXP
+/////////////////////////////////////////////////////////////////////////////
+static void charpoly_mtstate(unsigned long int* charpoly){
+   // sequence stored in reverse order so that the discrepancy is a
+   // word wise product with the connection polynomial
+   unsigned long int seq[BMSIZE] = {0};
+   unsigned long int conn[BMSIZE] = {0};
+   unsigned long int prev[BMSIZE] = {0};
+   unsigned long int tmp[BMSIZE];
+
+   rng_int_type rng_int = init_rng_int(1);
+   for (size_t n=0; n<BMLENGTH; n++){
+      size_t pos = BMLENGTH-1-n;
+      seq[pos/64] |= ((unsigned long int) next_random_lint(&rng_int) & 1ul) << (pos%64);
+   }
+
+   conn[0] = 1;
+   prev[0] = 1;
+   size_t len = 0;
+   size_t prevlen = 0;
+   size_t shift = 1;
+   for (size_t n=0; n<BMLENGTH; n++){
+      size_t offset = BMLENGTH-1-n;
+      unsigned long int discrepancy = 0;
+      for (size_t i=0; i<=len/64; i++){
+         discrepancy ^= conn[i] & extract_bits(seq, offset+64*i);
+      }
+
+      if (__builtin_parityl(discrepancy) == 0){
+         shift++;
+      } else if (2*len <= n){
+         memcpy(tmp, conn, sizeof(tmp));
+         add_shifted_poly(conn, BMSIZE, prev, prevlen/64+1, shift);
+         memcpy(prev, tmp, sizeof(tmp));
+         prevlen = len;
+         len = n+1-len;
+         shift = 1;
+      } else {
+         add_shifted_poly(conn, BMSIZE, prev, prevlen/64+1, shift);
+         shift++;
+      }
+   }
+
+   if (len != MEXP){
+      fprintf(stderr, "Error in determining the mersenne twister characteristic polynomial.");
+      abort();
+   }
+
+   // the characteristic polynomial is the reciprocal of the connection polynomial
+   memset(charpoly, 0, PSIZE*sizeof(unsigned long int));
+   for (size_t i=0; i<=len; i++){
+      if ((conn[i/64] >> (i%64)) & 1ul){
+         charpoly[(len-i)/64] |= 1ul << ((len-i)%64);
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Adds a word multiplied by x^shift to a polynomial. A negative shift
+//    drops the lowest bits of the word, which have to be zero.
+// Variables:
+//    poly: polynomial to add to
+//    word: 64 coefficients to add
+//    shift: power of x to multiply word with
+/////////////////////////////////////////////////////////////////////////////
+static inline void add_shifted_word(unsigned long int* poly, unsigned long int word,
+                                    long int shift){
+   if (shift < 0){
+      word >>= -shift;
+      shift = 0;
+   }
+   size_t iw = (size_t)shift/64;
+   unsigned int ib = (unsigned int)shift%64;
+   poly[iw] ^= word << ib;
+   if (ib != 0) {poly[iw+1] ^= word >> (64-ib);}
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Data for polynomial arithmetic modulo the characteristic polynomial
+// Variables:
+//    charpoly: characteristic polynomial
+//    nterms: number of nonzero coefficients below x^MEXP
+//    terms: powers of these coefficients
+/////////////////////////////////////////////////////////////////////////////
+typedef struct polymod_s {
+   unsigned long int charpoly[PSIZE] ;
+   int nterms ;
+   unsigned int terms[MEXP] ;
+} polymod_type;
+
+// the characteristic polynomial is the same for every jump, it is
+// determined on the first use
+static polymod_type mtpolymod;
+static pthread_once_t mtpolymod_once = PTHREAD_ONCE_INIT;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Sets up the shared data for polynomial arithmetic, run once
+/////////////////////////////////////////////////////////////////////////////
+static void init_mtpolymod(void){
+   charpoly_mtstate(mtpolymod.charpoly);
+   mtpolymod.nterms = 0;
+   for (unsigned int i=0; i<MEXP; i++){
+      if ((mtpolymod.charpoly[i/64] >> (i%64)) & 1ul){
+         mtpolymod.terms[mtpolymod.nterms++] = i;
+      }
+   }
+   // the next power below the leading one is x^(MEXP-311)
+   if (mtpolymod.terms[mtpolymod.nterms-1] > MEXP-64*REDUCEWORDS){
+      fprintf(stderr, "Error in setting up the jump polynomial arithmetic.");
+      abort();
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Gives the data for polynomial arithmetic. Only the first call
+//    determines the characteristic polynomial.
+// Return value:
+//    polymod: shared data
+/////////////////////////////////////////////////////////////////////////////
+static const polymod_type* get_polymod(void){
+   pthread_once(&mtpolymod_once, init_mtpolymod);
+   return &mtpolymod;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Squares a polynomial modulo the characteristic polynomial
+// Variables:
+//    poly: JUMPPOLYSIZE words holding a polynomial of degree < MEXP
+//    polymod: data of the characteristic polynomial
+/////////////////////////////////////////////////////////////////////////////
+static void square_polymod(unsigned long int* poly, const polymod_type* polymod){
+   unsigned long int sq[SQSIZE] = {0};
+
+   // squaring over GF(2) spreads the coefficients to the even powers
+   for (int i=0; i<JUMPPOLYSIZE; i++){
+      for (int ihalf=0; ihalf<2; ihalf++){
+         unsigned long int half = (poly[i] >> (32*ihalf)) & 0xFFFFFFFFul;
+         half = (half | (half << 16)) & 0x0000FFFF0000FFFFul;
+         half = (half | (half <<  8)) & 0x00FF00FF00FF00FFul;
+         half = (half | (half <<  4)) & 0x0F0F0F0F0F0F0F0Ful;
+         half = (half | (half <<  2)) & 0x3333333333333333ul;
+         half = (half | (half <<  1)) & 0x5555555555555555ul;
+         sq[2*i+ihalf] = half;
+      }
+   }
+
+   // eliminate all powers >= MEXP from the top. The sparse characteristic
+   // polynomial moves a block of REDUCEWORDS words below itself, so the
+   // block is eliminated at once with a shift per term. The words of the
+   // square above MEXP/64 form whole blocks.
+   for (int lo=2*JUMPPOLYSIZE-REDUCEWORDS; lo>MEXP/64; lo-=REDUCEWORDS){
+      unsigned long int quotient[REDUCEWORDS];
+      unsigned long int nonzero = 0;
+      for (int j=0; j<REDUCEWORDS; j++){
+         quotient[j] = sq[lo+j];
+         sq[lo+j] = 0;
+         nonzero |= quotient[j];
+      }
+      if (nonzero == 0) {continue;}
+      for (int it=0; it<polymod->nterms; it++){
+         size_t shift = 64*(size_t)lo - MEXP + polymod->terms[it];
+         unsigned long int* target = sq + shift/64;
+         unsigned int ib = shift%64;
+         // split shifts keep ib == 0 well defined
+         target[0] ^= quotient[0] << ib;
+         for (int j=1; j<REDUCEWORDS; j++){
+            target[j] ^= (quotient[j] << ib) | ((quotient[j-1] >> 1) >> (63-ib));
+         }
+         target[REDUCEWORDS] ^= (quotient[REDUCEWORDS-1] >> 1) >> (63-ib);
+      }
+   }
+   // the powers >= MEXP within the lowest word
+   unsigned long int quotient = sq[MEXP/64] & (~0ul << (MEXP%64));
+   sq[MEXP/64] ^= quotient;
+   for (int it=0; it<polymod->nterms && quotient!=0; it++){
+      add_shifted_word(sq, quotient, 64l*(MEXP/64) - MEXP + (long int)polymod->terms[it]);
+   }
+
+   memcpy(poly, sq, JUMPPOLYSIZE*sizeof(unsigned long int));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Multiplies a polynomial by x modulo the characteristic polynomial
+// Variables:
+//    poly: JUMPPOLYSIZE words holding a polynomial of degree < MEXP
+//    polymod: data of the characteristic polynomial
+/////////////////////////////////////////////////////////////////////////////
+static void mulx_polymod(unsigned long int* poly, const polymod_type* polymod){
+   for (int i=JUMPPOLYSIZE-1; i>0; i--){
+      poly[i] = (poly[i] << 1) | (poly[i-1] >> 63);
+   }
+   poly[0] <<= 1;
+   if ((poly[MEXP/64] >> (MEXP%64)) & 1ul){
+      for (int i=0; i<JUMPPOLYSIZE; i++){
+         poly[i] ^= polymod->charpoly[i];
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Divides a polynomial by x modulo the characteristic polynomial
+//    The inverse of x exists as the constant coefficient of the
+//    characteristic polynomial is one.
+// Variables:
+//    poly: JUMPPOLYSIZE words holding a polynomial of degree < MEXP
+//    polymod: data of the characteristic polynomial
+/////////////////////////////////////////////////////////////////////////////
+static void divx_polymod(unsigned long int* poly, const polymod_type* polymod){
+   if (poly[0] & 1ul){
+      for (int i=0; i<JUMPPOLYSIZE; i++){
+         poly[i] ^= polymod->charpoly[i];
+      }
+   }
+   for (int i=0; i<JUMPPOLYSIZE-1; i++){
+      poly[i] = (poly[i] >> 1) | (poly[i+1] << 63);
+   }
+   poly[JUMPPOLYSIZE-1] >>= 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Computes the jump polynomial to move a state by 2^log2steps steps
+// Variables:
+//    log2steps: base 2 logarithm of the jump distance
+// Return value:
+//    jump_poly: jump polynomial
+/////////////////////////////////////////////////////////////////////////////
+jump_poly_type init_jump_poly(unsigned int log2steps){
+   jump_poly_type jump_poly;
+   const polymod_type* polymod = get_polymod();
+
+   memset(jump_poly.coeffs, 0, sizeof(jump_poly.coeffs));
+   jump_poly.coeffs[0] = 2ul;
+   for (unsigned int i=0; i<log2steps; i++){
+      square_polymod(jump_poly.coeffs, polymod);
+   }
+   divx_polymod(jump_poly.coeffs, polymod);
+   jump_poly.identity = false;
+
+   return jump_poly;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Computes the jump polynomial to move a state by nsteps steps
+// Variables:
+//    nsteps: jump distance
+// Return value:
+//    jump_poly: jump polynomial
+/////////////////////////////////////////////////////////////////////////////
+jump_poly_type init_jump_poly_steps(uint64_t nsteps){
+   jump_poly_type jump_poly;
+
+   memset(jump_poly.coeffs, 0, sizeof(jump_poly.coeffs));
+   jump_poly.identity = nsteps == 0;
+   if (jump_poly.identity) {return jump_poly;}
+
+   const polymod_type* polymod = get_polymod();
+   jump_poly.coeffs[0] = 1ul;
+   for (int ibit=63-__builtin_clzl(nsteps); ibit>=0; ibit--){
+      square_polymod(jump_poly.coeffs, polymod);
+      if ((nsteps >> ibit) & 1ul){
+         mulx_polymod(jump_poly.coeffs, polymod);
+      }
+   }
+   divx_polymod(jump_poly.coeffs, polymod);
+
+   return jump_poly;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Advances a mersenne twister window stored as ring buffer by one
+//    number. The oldest number is replaced by the newly generated one.
+// Variables:
+//    window: NN consecutive numbers of the sequence
+//    start: position of the oldest number in the ring buffer
+/////////////////////////////////////////////////////////////////////////////
+static inline void step_window(unsigned long int* window, int* start){
+   int i = *start;
+   int ip1 = i+1 < NN ? i+1 : i+1-NN;
+   int ipm = i+MM < NN ? i+MM : i+MM-NN;
+   unsigned long int rng = (window[i] & UM) ^ (window[ip1] & LM);
+   window[i] = (window[ipm] ^ (rng>>1)) ^ (mag[(rng& 1)]) ;
+   *start = ip1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Moves an int random number state forward by the distance of a
+//    jump polynomial
+//    The polynomial p(x) = x^(nsteps-1) is evaluated on the state with
+//    Horner's scheme and one ordinary step follows. The extra step
+//    restores the lower bits of the first number that do not take part
+//    in the recurrence and are not reproduced by the polynomial.
+//    The jump moves to another part of the sequence and does not count
+//    towards the instrumented position.
+// Variables:
+//    rng_int: Random number generator state
+//    jump_poly: jump polynomial
+/////////////////////////////////////////////////////////////////////////////
+void rng_int_jump(rng_int_type* rng_int, const jump_poly_type* jump_poly){
+   if (jump_poly->identity) {return;}
+
+   uint64_t position = get_instrument_position(rng_int);
+   if (rng_int->mtidx > NN-2){
+      regenerate_mtstate(rng_int->mtstate);
+      rng_int->mtidx = -1 ;
+   }
+   // numbers of the current state that were already used
+   int nused = rng_int->mtidx + 1;
+
+   unsigned long int window[NN];
+   unsigned long int jumped[NN] = {0};
+   int start = 0;
+   memcpy(window, rng_int->mtstate, sizeof(window));
+
+   int degree = MEXP-1;
+   while (degree > 0 &&
+          !((jump_poly->coeffs[degree/64] >> (degree%64)) & 1ul)){
+      degree--;
+   }
+   for (int i=degree; i>=0; i--){
+      step_window(jumped, &start);
+      if ((jump_poly->coeffs[i/64] >> (i%64)) & 1ul){
+         for (int j=0; j<NN-start; j++){
+            jumped[start+j] ^= window[j];
+         }
+         for (int j=NN-start; j<NN; j++){
+            jumped[j-NN+start] ^= window[j];
+         }
+      }
+   }
+
+   for (int i=0; i<=nused; i++){
+      step_window(jumped, &start);
+   }
+
+   memcpy(rng_int->mtstate, jumped+start, (NN-start)*sizeof(unsigned long int));
+   memcpy(rng_int->mtstate+NN-start, jumped, start*sizeof(unsigned long int));
+   rng_int->mtidx = -1;
+   set_instrument_position(rng_int, position);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Moves a uniform random number state forward by the distance of a
+//    jump polynomial
+// Variables:
+//    rng_uniform: Random number generator state
+//    jump_poly: jump polynomial
+/////////////////////////////////////////////////////////////////////////////
+void rng_uniform_jump(rng_uniform_type* rng_uniform, const jump_poly_type* jump_poly){
+   rng_int_jump(&rng_uniform->rng_int, jump_poly);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Moves a gaussian random number state forward by the distance of a
+//    jump polynomial. A pending second Box-Muller number is dropped.
+// Variables:
+//    rng_gaussian: Random number generator state
+//    jump_poly: jump polynomial
+/////////////////////////////////////////////////////////////////////////////
+void rng_gaussian_jump(rng_gaussian_type* rng_gaussian, const jump_poly_type* jump_poly){
+   rng_uniform_jump(&rng_gaussian->rng_uniform, jump_poly);
+   rng_gaussian->generated = false;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Skips the next n numbers of an int random number state
+//    Short distances are skipped by regenerating the state without
+//    tempering, long distances with a jump polynomial.
+// Variables:
+//    rng_int: Random number generator state
+//    n: number of random numbers to skip
+/////////////////////////////////////////////////////////////////////////////
+void rng_int_discard(rng_int_type* rng_int, uint64_t n){
+   if (n >= DISCARD_JUMPTHRESHOLD){
+      uint64_t position = get_instrument_position(rng_int);
+      jump_poly_type jump_poly = init_jump_poly_steps(n);
+      rng_int_jump(rng_int, &jump_poly);
+      set_instrument_position(rng_int, position+n);
+      return;
+   }
+
+   while (n > 0){
+      if (rng_int->mtidx > NN-2){
+         regenerate_rng_int(rng_int);
+      }
+      uint64_t nskip = (uint64_t) (NN-1 - rng_int->mtidx);
+      if (nskip > n) {nskip = n;}
+      rng_int->mtidx += (int) nskip;
+      n -= nskip;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Skips the next n numbers of a uniform random number state
+// Variables:
+//    rng_uniform: Random number generator state
+//    n: number of random numbers to skip
+/////////////////////////////////////////////////////////////////////////////
+void rng_uniform_discard(rng_uniform_type* rng_uniform, uint64_t n){
+   rng_int_discard(&rng_uniform->rng_int, n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Skips the next n underlying uniform numbers of a gaussian random
+//    number state. A pending second Box-Muller number is dropped.
+// Variables:
+//    rng_gaussian: Random number generator state
+//    n: number of uniform random numbers to skip
+/////////////////////////////////////////////////////////////////////////////
+void rng_gaussian_discard(rng_gaussian_type* rng_gaussian, uint64_t n){
+   rng_uniform_discard(&rng_gaussian->rng_uniform, n);
+   rng_gaussian->generated = false;
+}
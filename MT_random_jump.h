@@ -0,0 +1,132 @@
+#ifndef MT_RANDOM_JUMP_H
+#define MT_RANDOM_JUMP_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to move a mersenne twister state forward by an
+   //    arbitrary number of steps without generating the skipped numbers.
+   //    Jumping one state repeatedly by the same distance hands out
+   //    substreams that are guaranteed not to overlap.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_jump.h"
+   //    Precompute a jump polynomial for 2^log2steps or nsteps steps.
+   //    This is expensive and should be done once per distance:
+   //       jump_poly = init_jump_poly(log2steps) ;
+   //       jump_poly = init_jump_poly_steps(nsteps) ;
+   //    Move a state forward by the distance of the jump polynomial:
+   //       rng_int_jump(&rng_statei, &jump_poly) ;
+   //       rng_uniform_jump(&rng_stateu, &jump_poly) ;
+   //       rng_gaussian_jump(&rng_stateg, &jump_poly) ;
+   //    Skip the next n numbers of a state:
+   //       rng_int_discard(&rng_statei, n) ;
+   //       rng_uniform_discard(&rng_stateu, n) ;
+   //       rng_gaussian_discard(&rng_stateg, n) ;
+   //    The distances count 64 bit numbers as returned by next_random_lint.
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stdbool.h>
+   #include <stdint.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   #define JUMPPOLYSIZE 312
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold a jump polynomial
+   // Variables:
+   //    identity: Boolean if the jump does not move the state
+   //    coeffs: GF(2) coefficients of x^(nsteps-1) modulo the characteristic
+   //            polynomial of the mersenne twister
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct jump_poly_s {
+      bool identity ;
+      unsigned long int coeffs[JUMPPOLYSIZE] ;
+   } jump_poly_type;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Computes the jump polynomial to move a state by 2^log2steps steps
+   // Variables:
+   //    log2steps: base 2 logarithm of the jump distance
+   // Return value:
+   //    jump_poly: jump polynomial
+   /////////////////////////////////////////////////////////////////////////////
+   jump_poly_type init_jump_poly(unsigned int log2steps);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Computes the jump polynomial to move a state by nsteps steps
+   // Variables:
+   //    nsteps: jump distance
+   // Return value:
+   //    jump_poly: jump polynomial
+   /////////////////////////////////////////////////////////////////////////////
+   jump_poly_type init_jump_poly_steps(uint64_t nsteps);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Moves an int random number state forward by the distance of a
+   //    jump polynomial
+   // Variables:
+   //    rng_int: Random number generator state
+   //    jump_poly: jump polynomial
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_int_jump(rng_int_type* rng_int, const jump_poly_type* jump_poly);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Moves a uniform random number state forward by the distance of a
+   //    jump polynomial
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    jump_poly: jump polynomial
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_uniform_jump(rng_uniform_type* rng_uniform, const jump_poly_type* jump_poly);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Moves a gaussian random number state forward by the distance of a
+   //    jump polynomial. A pending second Box-Muller number is dropped.
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   //    jump_poly: jump polynomial
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_gaussian_jump(rng_gaussian_type* rng_gaussian, const jump_poly_type* jump_poly);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Skips the next n numbers of an int random number state
+   // Variables:
+   //    rng_int: Random number generator state
+   //    n: number of random numbers to skip
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_int_discard(rng_int_type* rng_int, uint64_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Skips the next n numbers of a uniform random number state
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    n: number of random numbers to skip
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_uniform_discard(rng_uniform_type* rng_uniform, uint64_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Skips the next n underlying uniform numbers of a gaussian random
+   //    number state. A pending second Box-Muller number is dropped.
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   //    n: number of uniform random numbers to skip
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_gaussian_discard(rng_gaussian_type* rng_gaussian, uint64_t n);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
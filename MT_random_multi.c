@@ -0,0 +1,102 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "MT_random.h"
+#include "MT_random_internal.h"
+#include "MT_random_multi.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes MTMULTILANES int random number generators
+// Variables:
+//    seeds: MTMULTILANES seeds, one per lane
+// Return value:
+//    rng_int_multi: interleaved random number states
+/////////////////////////////////////////////////////////////////////////////
+rng_int_multi_type init_rng_int_multi(const int* seeds){
+   rng_int_multi_type rng_int_multi;
+
+   for (int lane=0; lane<MTMULTILANES; lane++){
+      rng_int_type rng_int = init_rng_int(seeds[lane]);
+      rng_int_multi.seed[lane] = rng_int.seed;
+      for (int i=0; i<NN; i++){
+         rng_int_multi.mtstate[i*MTMULTILANES+lane] = rng_int.mtstate[i];
+      }
+   }
+   rng_int_multi.mtidx = NN+1;
+   return rng_int_multi;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next long int random number of every lane
+// Variables:
+//    rng_int_multi: interleaved random number states
+//    randnums: array to hold MTMULTILANES random numbers
+/////////////////////////////////////////////////////////////////////////////
+void next_random_lint_multi(rng_int_multi_type* rng_int_multi, long int* randnums){
+
+   // if pool of random numbers is drained create a set of new ones
+   if (rng_int_multi->mtidx > NN-2){
+      regenerate_mtstate_lanes(rng_int_multi->mtstate, MTMULTILANES);
+      rng_int_multi->mtidx = -1 ;
+   }
+
+   rng_int_multi->mtidx += 1 ;
+   const long int* row = rng_int_multi->mtstate + rng_int_multi->mtidx*MTMULTILANES;
+   for (int lane=0; lane<MTMULTILANES; lane++){
+      randnums[lane] = (long int) temper_rng_int(row[lane]);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next n long int random numbers of every lane.
+//    The rows of the states are stored in the order of the output,
+//    so every chunk is tempered as one consecutive block.
+// Variables:
+//    rng_int_multi: interleaved random number states
+//    randnums: array to hold n*MTMULTILANES random numbers
+//    n: number of random numbers to generate per lane
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_lint_multi(rng_int_multi_type* rng_int_multi, long int* randnums, size_t n){
+   while (n > 0){
+      if (rng_int_multi->mtidx > NN-2){
+         regenerate_mtstate_lanes(rng_int_multi->mtstate, MTMULTILANES);
+         rng_int_multi->mtidx = -1 ;
+      }
+
+      size_t nchunk = (size_t) (NN-1 - rng_int_multi->mtidx);
+      if (nchunk > n) {nchunk = n;}
+
+      temper_mtstate(rng_int_multi->mtstate + (rng_int_multi->mtidx+1)*MTMULTILANES,
+                     randnums, nchunk*MTMULTILANES);
+      rng_int_multi->mtidx += (int) nchunk;
+      randnums += nchunk*MTMULTILANES;
+      n -= nchunk;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Extracts the state of a single lane
+// Variables:
+//    rng_int_multi: interleaved random number states
+//    lane: index of the lane
+// Return value:
+//    rng_int: int random number state that continues the stream of the lane
+/////////////////////////////////////////////////////////////////////////////
+rng_int_type get_rng_int_multi_lane(const rng_int_multi_type* rng_int_multi, int lane){
+   if (lane < 0 || lane >= MTMULTILANES){
+      fprintf(stderr, "Error in extracting lane %d of %d interleaved states.", lane, MTMULTILANES);
+      abort();
+   }
+
+   rng_int_type rng_int;
+   rng_int.seed = rng_int_multi->seed[lane];
+   rng_int.mtidx = rng_int_multi->mtidx;
+   for (int i=0; i<NN; i++){
+      rng_int.mtstate[i] = rng_int_multi->mtstate[i*MTMULTILANES+lane];
+   }
+   reset_instrument(&rng_int);
+   return rng_int;
+}
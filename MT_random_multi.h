@@ -0,0 +1,94 @@
+#ifndef MT_RANDOM_MULTI_H
+#define MT_RANDOM_MULTI_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to advance MTMULTILANES independent mersenne twister
+   //    streams together. The states are interleaved element by element, so
+   //    the twist and the tempering of all streams run as one vectorized pass
+   //    over a contiguous array. Every lane produces exactly the numbers of a
+   //    rng_int_type initialized with the same seed.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_multi.h"
+   //    Initialize the state with one seed per lane:
+   //       rng_statem = init_rng_int_multi(seeds)
+   //    Get the next random number of every lane:
+   //       next_random_lint_multi(&rng_statem, random_numbers) ;
+   //    Fill an array with the next n random numbers of every lane,
+   //    number i of lane l is stored at random_numbers[i*MTMULTILANES+l]:
+   //       fill_random_lint_multi(&rng_statem, random_numbers, n) ;
+   //    Extract a lane as standalone state that continues its stream:
+   //       rng_statei = get_rng_int_multi_lane(&rng_statem, lane)
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   #define MTMULTILANES 8
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold the interleaved states of MTMULTILANES int random number
+   //    generators
+   // Variables:
+   //    seed: The seeds of the lanes
+   //    mtidx: index of the current random number of the current states
+   //    mtstate: States of the mersenne twisters, element i of lane l
+   //             is stored at i*MTMULTILANES+l
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_int_multi_s {
+      int seed[MTMULTILANES] ;
+      int mtidx ;
+      long int mtstate[MTSTATESIZE*MTMULTILANES] ;
+   } rng_int_multi_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes MTMULTILANES int random number generators
+   // Variables:
+   //    seeds: MTMULTILANES seeds, one per lane
+   // Return value:
+   //    rng_int_multi: interleaved random number states
+   /////////////////////////////////////////////////////////////////////////////
+   rng_int_multi_type init_rng_int_multi(const int* seeds);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next long int random number of every lane
+   // Variables:
+   //    rng_int_multi: interleaved random number states
+   //    randnums: array to hold MTMULTILANES random numbers
+   /////////////////////////////////////////////////////////////////////////////
+   void next_random_lint_multi(rng_int_multi_type* rng_int_multi, long int* randnums);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next n long int random numbers of every lane.
+   //    Number i of lane l is stored at randnums[i*MTMULTILANES+l].
+   // Variables:
+   //    rng_int_multi: interleaved random number states
+   //    randnums: array to hold n*MTMULTILANES random numbers
+   //    n: number of random numbers to generate per lane
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_lint_multi(rng_int_multi_type* rng_int_multi, long int* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Extracts the state of a single lane
+   // Variables:
+   //    rng_int_multi: interleaved random number states
+   //    lane: index of the lane
+   // Return value:
+   //    rng_int: int random number state that continues the stream of the lane
+   /////////////////////////////////////////////////////////////////////////////
+   rng_int_type get_rng_int_multi_lane(const rng_int_multi_type* rng_int_multi, int lane);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
@@ -0,0 +1,174 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "MT_random.h"
+#include "MT_random_jump.h"
+#include "MT_random_parallel.h"
+
+// the jump polynomial and a jump of the state cost about as much as
+// generating 2^19 numbers each, shorter parts than this are generated
+// faster by a single thread
+#define PARALLEL_MINLENGTH (1ul<<21)
+
+typedef enum {
+   PARALLEL_LINT,
+   PARALLEL_INT,
+   PARALLEL_UNIFORM
+} parallel_kind_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Part of a parallel fill handled by a single thread
+// Variables:
+//    kind: type of the random numbers
+//    rng_uniform: state at the start of the part, only rng_int is used
+//                 for int random numbers
+//    randnums: first element of the part
+//    n: number of random numbers of the part
+/////////////////////////////////////////////////////////////////////////////
+typedef struct parallel_part_s {
+   parallel_kind_type kind ;
+   rng_uniform_type rng_uniform ;
+   void* randnums ;
+   size_t n ;
+} parallel_part_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills the array of a part with the serial fill routine
+// Variables:
+//    arg: part to fill
+// Return value:
+//    NULL
+/////////////////////////////////////////////////////////////////////////////
+static void* fill_parallel_part(void* arg){
+   parallel_part_type* part = (parallel_part_type*) arg;
+
+   switch (part->kind){
+      case PARALLEL_LINT:
+         fill_random_lint(&part->rng_uniform.rng_int, (long int*) part->randnums, part->n);
+         break;
+      case PARALLEL_INT:
+         fill_random_int(&part->rng_uniform.rng_int, (int*) part->randnums, part->n);
+         break;
+      case PARALLEL_UNIFORM:
+         fill_random_uniform(&part->rng_uniform, (double*) part->randnums, part->n);
+         break;
+   }
+   return NULL;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Splits an array into one part per thread and fills the parts
+//    concurrently. The state of each part is obtained by a jump from the
+//    state of the previous part, and the threads are started as soon as
+//    their state is known. If a thread cannot be created its part is
+//    filled by the calling thread.
+// Variables:
+//    kind: type of the random numbers
+//    rng_uniform: Random number generator state
+//    randnums: array to hold the random numbers
+//    elemsize: size of a random number in bytes
+//    n: number of random numbers to generate
+//    nthreads: maximum number of threads to use
+/////////////////////////////////////////////////////////////////////////////
+static void parallel_fill(parallel_kind_type kind, rng_uniform_type* rng_uniform,
+                          void* randnums, size_t elemsize, size_t n, int nthreads){
+   if (nthreads < 1) {nthreads = 1;}
+   if ((size_t) nthreads > n/PARALLEL_MINLENGTH) {nthreads = (int) (n/PARALLEL_MINLENGTH);}
+
+   parallel_part_type part = {kind, *rng_uniform, randnums, n};
+   if (nthreads <= 1){
+      fill_parallel_part(&part);
+      *rng_uniform = part.rng_uniform;
+      return;
+   }
+
+   parallel_part_type* parts = (parallel_part_type*) malloc(nthreads*sizeof(parallel_part_type));
+   pthread_t* threads = (pthread_t*) malloc(nthreads*sizeof(pthread_t));
+   bool* started = (bool*) malloc(nthreads*sizeof(bool));
+   if (parts == NULL || threads == NULL || started == NULL){
+      fprintf(stderr, "Error in allocating parallel fill workspace.");
+      abort();
+   }
+
+   size_t partlength = (n + nthreads-1) / nthreads;
+   jump_poly_type jump_poly = init_jump_poly_steps(partlength);
+   for (int ithread=0; ithread<nthreads; ithread++){
+      size_t offset = ithread*partlength;
+      parts[ithread].kind = kind;
+      parts[ithread].rng_uniform = *rng_uniform;
+      parts[ithread].randnums = (char*) randnums + offset*elemsize;
+      parts[ithread].n = offset+partlength < n ? partlength : n-offset;
+
+      if (ithread < nthreads-1){
+         rng_uniform_jump(rng_uniform, &jump_poly);
+      }
+
+      started[ithread] = pthread_create(&threads[ithread], NULL,
+                                        fill_parallel_part, &parts[ithread]) == 0;
+   }
+
+   for (int ithread=0; ithread<nthreads; ithread++){
+      if (started[ithread]){
+         pthread_join(threads[ithread], NULL);
+      } else {
+         fill_parallel_part(&parts[ithread]);
+      }
+   }
+
+   // the last part ends where the serial fill would end
+   *rng_uniform = parts[nthreads-1].rng_uniform;
+
+   free(started);
+   free(threads);
+   free(parts);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next long int random numbers using several
+//    threads. The numbers are identical to fill_random_lint.
+// Variables:
+//    rng_int: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+//    nthreads: maximum number of threads to use
+/////////////////////////////////////////////////////////////////////////////
+void parallel_fill_random_lint(rng_int_type* rng_int, long int* randnums, size_t n, int nthreads){
+   rng_uniform_type rng_uniform = {0.0, 1.0, *rng_int};
+   parallel_fill(PARALLEL_LINT, &rng_uniform, randnums, sizeof(long int), n, nthreads);
+   *rng_int = rng_uniform.rng_int;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next int random numbers using several
+//    threads. The numbers are identical to fill_random_int.
+// Variables:
+//    rng_int: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+//    nthreads: maximum number of threads to use
+/////////////////////////////////////////////////////////////////////////////
+void parallel_fill_random_int(rng_int_type* rng_int, int* randnums, size_t n, int nthreads){
+   rng_uniform_type rng_uniform = {0.0, 1.0, *rng_int};
+   parallel_fill(PARALLEL_INT, &rng_uniform, randnums, sizeof(int), n, nthreads);
+   *rng_int = rng_uniform.rng_int;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next uniform random numbers using several
+//    threads. The numbers are identical to fill_random_uniform.
+// Variables:
+//    rng_uniform: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+//    nthreads: maximum number of threads to use
+/////////////////////////////////////////////////////////////////////////////
+void parallel_fill_random_uniform(rng_uniform_type* rng_uniform, double* randnums, size_t n, int nthreads){
+   parallel_fill(PARALLEL_UNIFORM, rng_uniform, randnums, sizeof(double), n, nthreads);
+}
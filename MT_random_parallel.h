@@ -0,0 +1,72 @@
+#ifndef MT_RANDOM_PARALLEL_H
+#define MT_RANDOM_PARALLEL_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to fill large arrays with random numbers using
+   //    several threads. The array is split into one contiguous part per
+   //    thread and the state of every thread is moved to the start of its
+   //    part with a jump. The result is bit-identical to the serial fill
+   //    routines, independent of the number of threads and their scheduling,
+   //    and the state is afterwards advanced exactly as by the serial fill.
+   //    Arrays that are too short to amortize the jumps are filled serially.
+   //    Requires linking with -pthread.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_parallel.h"
+   //    Fill an array with the next n random numbers using nthreads threads:
+   //       Uniform:
+   //          parallel_fill_random_uniform(&rng_stateu, random_numbers, n, nthreads) ;
+   //       Int:
+   //          parallel_fill_random_int(&rng_statei, random_numbers, n, nthreads) ;
+   //       Long int:
+   //          parallel_fill_random_lint(&rng_statei, random_numbers, n, nthreads) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next long int random numbers using several
+   //    threads. The numbers are identical to fill_random_lint.
+   // Variables:
+   //    rng_int: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   //    nthreads: maximum number of threads to use
+   /////////////////////////////////////////////////////////////////////////////
+   void parallel_fill_random_lint(rng_int_type* rng_int, long int* randnums, size_t n, int nthreads);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next int random numbers using several
+   //    threads. The numbers are identical to fill_random_int.
+   // Variables:
+   //    rng_int: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   //    nthreads: maximum number of threads to use
+   /////////////////////////////////////////////////////////////////////////////
+   void parallel_fill_random_int(rng_int_type* rng_int, int* randnums, size_t n, int nthreads);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next uniform random numbers using several
+   //    threads. The numbers are identical to fill_random_uniform.
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   //    nthreads: maximum number of threads to use
+   /////////////////////////////////////////////////////////////////////////////
+   void parallel_fill_random_uniform(rng_uniform_type* rng_uniform, double* randnums, size_t n, int nthreads);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
@@ -0,0 +1,204 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "MT_random.h"
+#include "MT_random_pool.h"
+
+#define POOL_WORDBITS 64
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns a slot of a pool
+// Variables:
+//    pool: pool of states
+//    index: index of the slot
+// Return value:
+//    slot: slot with the index
+/////////////////////////////////////////////////////////////////////////////
+static inline rng_pool_slot_type* get_rng_pool_slot(const rng_pool_type* pool, size_t index){
+   return (rng_pool_slot_type*) (pool->slots + index*pool->stride);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a pool of uniform random number states
+// Variables:
+//    seed: master seed of the pool
+//    nstates: number of states, positive and small enough for the slots
+//             to fit into a size_t
+//    lower: lower bound of random numbers
+//    upper: upper bound of random numbers
+// Return value:
+//    pool: pool that needs to be freed with free_rng_pool
+/////////////////////////////////////////////////////////////////////////////
+rng_pool_type* create_rng_pool(int seed, size_t nstates, double lower, double upper){
+   if (nstates == 0){
+      fprintf(stderr, "Error in creating random number pool without states.");
+      abort();
+   }
+   size_t stride = (sizeof(rng_pool_slot_type) + RNG_POOL_CACHELINESIZE - 1)
+                   / RNG_POOL_CACHELINESIZE * RNG_POOL_CACHELINESIZE;
+   if (nstates > SIZE_MAX/stride){
+      fprintf(stderr, "Error in creating random number pool of %zu states.", nstates);
+      abort();
+   }
+
+   rng_pool_type* pool = (rng_pool_type*) malloc(sizeof(rng_pool_type));
+   if (pool == NULL){
+      fprintf(stderr, "Error in allocating random number pool.");
+      abort();
+   }
+   pool->nstates = nstates;
+   pool->stride = stride;
+   pool->nwords = nstates/POOL_WORDBITS + (nstates%POOL_WORDBITS != 0);
+
+   void* slots = NULL;
+   void* inuse = NULL;
+   if (posix_memalign(&slots, RNG_POOL_CACHELINESIZE, nstates*pool->stride) != 0 ||
+       posix_memalign(&inuse, RNG_POOL_CACHELINESIZE, pool->nwords*sizeof(uint64_t)) != 0){
+      fprintf(stderr, "Error in allocating random number pool.");
+      abort();
+   }
+   pool->slots = (unsigned char*) slots;
+   pool->inuse = (uint64_t*) inuse;
+   memset(pool->inuse, 0, pool->nwords*sizeof(uint64_t));
+
+   for (size_t i=0; i<nstates; i++){
+      rng_pool_slot_type* slot = get_rng_pool_slot(pool, i);
+      uint64_t key[2] = {(uint64_t) (unsigned int) seed, (uint64_t) i};
+      slot->rng_uniform.lower = lower;
+      slot->rng_uniform.upper = upper;
+      init_rng_int_by_array64(&slot->rng_uniform.rng_int, key, 2);
+      slot->nvalues = 0;
+      slot->nacquires = 0;
+   }
+
+   pool->ninuse = 0;
+   pool->peakinuse = 0;
+   pool->nacquires = 0;
+   pool->nfailed = 0;
+   return pool;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Frees a pool, no slot may be in use anymore
+// Variables:
+//    pool: pool to free
+/////////////////////////////////////////////////////////////////////////////
+void free_rng_pool(rng_pool_type* pool){
+   if (__atomic_load_n(&pool->ninuse, __ATOMIC_ACQUIRE) != 0){
+      fprintf(stderr, "Error in freeing random number pool with slots in use.");
+      abort();
+   }
+   free(pool->slots);
+   free(pool->inuse);
+   free(pool);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Takes a free slot of the pool for exclusive use. The first free bit
+//    of the bitmap is claimed with a compare and swap, a failed swap
+//    retries with the updated word.
+// Variables:
+//    pool: pool of states
+// Return value:
+//    slot: acquired slot, NULL if all slots are in use
+/////////////////////////////////////////////////////////////////////////////
+rng_pool_slot_type* acquire_rng_pool_slot(rng_pool_type* pool){
+   for (size_t iword=0; iword<pool->nwords; iword++){
+      size_t nbits = pool->nstates - iword*POOL_WORDBITS;
+      uint64_t valid = nbits >= POOL_WORDBITS ? ~(uint64_t) 0 : ((uint64_t) 1 << nbits) - 1;
+      uint64_t word = __atomic_load_n(&pool->inuse[iword], __ATOMIC_RELAXED);
+
+      while ((~word & valid) != 0){
+         int bit = __builtin_ctzl(~word & valid);
+         if (__atomic_compare_exchange_n(&pool->inuse[iword], &word, word | ((uint64_t) 1 << bit),
+                                         false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)){
+            size_t ninuse = __atomic_add_fetch(&pool->ninuse, 1, __ATOMIC_RELAXED);
+            size_t peak = __atomic_load_n(&pool->peakinuse, __ATOMIC_RELAXED);
+            while (ninuse > peak &&
+                   !__atomic_compare_exchange_n(&pool->peakinuse, &peak, ninuse,
+                                                false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+            __atomic_add_fetch(&pool->nacquires, 1, __ATOMIC_RELAXED);
+
+            rng_pool_slot_type* slot = get_rng_pool_slot(pool, iword*POOL_WORDBITS + bit);
+            slot->nacquires++;
+            return slot;
+         }
+      }
+   }
+
+   __atomic_add_fetch(&pool->nfailed, 1, __ATOMIC_RELAXED);
+   return NULL;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Returns a slot to the pool, the state keeps its position
+// Variables:
+//    pool: pool of states
+//    slot: slot acquired from the pool
+/////////////////////////////////////////////////////////////////////////////
+void release_rng_pool_slot(rng_pool_type* pool, rng_pool_slot_type* slot){
+   size_t index = (size_t) ((unsigned char*) slot - pool->slots) / pool->stride;
+   uint64_t mask = (uint64_t) 1 << (index % POOL_WORDBITS);
+
+   uint64_t word = __atomic_fetch_and(&pool->inuse[index/POOL_WORDBITS], ~mask, __ATOMIC_RELEASE);
+   if ((word & mask) == 0){
+      fprintf(stderr, "Error in releasing random number pool slot %zu that is not in use.", index);
+      abort();
+   }
+   __atomic_sub_fetch(&pool->ninuse, 1, __ATOMIC_RELAXED);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next uniform random number of a slot
+// Variables:
+//    slot: acquired slot
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+double next_random_uniform_pool(rng_pool_slot_type* slot){
+   __atomic_store_n(&slot->nvalues, slot->nvalues+1, __ATOMIC_RELAXED);
+   return next_random_uniform(&slot->rng_uniform);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next uniform random numbers of a slot
+// Variables:
+//    slot: acquired slot
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_uniform_pool(rng_pool_slot_type* slot, double* randnums, size_t n){
+   __atomic_store_n(&slot->nvalues, slot->nvalues+n, __ATOMIC_RELAXED);
+   fill_random_uniform(&slot->rng_uniform, randnums, n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Collects the usage statistics of a pool
+// Variables:
+//    pool: pool of states
+// Return value:
+//    stats: usage statistics
+/////////////////////////////////////////////////////////////////////////////
+rng_pool_stats_type get_rng_pool_stats(const rng_pool_type* pool){
+   rng_pool_stats_type stats;
+   stats.nstates = pool->nstates;
+   stats.ninuse = __atomic_load_n(&pool->ninuse, __ATOMIC_RELAXED);
+   stats.peakinuse = __atomic_load_n(&pool->peakinuse, __ATOMIC_RELAXED);
+   stats.nacquires = __atomic_load_n(&pool->nacquires, __ATOMIC_RELAXED);
+   stats.nfailed = __atomic_load_n(&pool->nfailed, __ATOMIC_RELAXED);
+   stats.nvalues = 0;
+   for (size_t i=0; i<pool->nstates; i++){
+      stats.nvalues += __atomic_load_n(&get_rng_pool_slot(pool, i)->nvalues, __ATOMIC_RELAXED);
+   }
+   return stats;
+}
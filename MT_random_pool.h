@@ -0,0 +1,177 @@
+#ifndef MT_RANDOM_POOL_H
+#define MT_RANDOM_POOL_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to manage a pool of uniform random number states
+   //    for multithreaded programs. Every state lives in its own slot that
+   //    starts at a cache line boundary and is padded to whole cache lines,
+   //    so threads working on neighbouring states never share a cache line.
+   //    Slots are handed out and returned lock free through an atomic bitmap.
+   //    The states are seeded from one master seed with the keys
+   //    {seed, slot index} of init_by_array64, so the pool is reproducible.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_pool.h"
+   //    Create a pool of nstates states:
+   //       pool = create_rng_pool(seed, nstates, lowerbound, upperbound) ;
+   //    Take a free slot in a thread (NULL if all are in use) and keep it
+   //    for the lifetime of the thread:
+   //       slot = acquire_rng_pool_slot(pool) ;
+   //    Get the next random number or fill an array with the next n random
+   //    numbers, the numbers are counted in the slot:
+   //       random_number = next_random_uniform_pool(slot) ;
+   //       fill_random_uniform_pool(slot, random_numbers, n) ;
+   //    The state slot->rng_uniform can also be used with all routines of
+   //    MT_random.h directly, but the numbers are not counted.
+   //    Return the slot:
+   //       release_rng_pool_slot(pool, slot) ;
+   //    Get the usage statistics:
+   //       stats = get_rng_pool_stats(pool) ;
+   //    Free the pool after all slots are released:
+   //       free_rng_pool(pool) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include <stdint.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   #define RNG_POOL_CACHELINESIZE 64
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Slot of a pool that holds one state
+   // Variables:
+   //    rng_uniform: uniform random number state
+   //    nvalues: numbers drawn through the pool routines
+   //    nacquires: number of times the slot was acquired
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_pool_slot_s {
+      rng_uniform_type rng_uniform ;
+      unsigned long int nvalues ;
+      unsigned long int nacquires ;
+   } rng_pool_slot_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold a pool of states. Only to be used through the routines.
+   // Variables:
+   //    nstates: number of states
+   //    stride: distance of the slots in bytes, a multiple of the cache line
+   //    slots: cache line aligned memory of the slots
+   //    nwords: number of words of the bitmap
+   //    inuse: bitmap of the slots in use
+   //    ninuse, peakinuse: current and largest number of slots in use
+   //    nacquires, nfailed: successful and failed acquisitions
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_pool_s {
+      size_t nstates ;
+      size_t stride ;
+      unsigned char* slots ;
+      size_t nwords ;
+      uint64_t* inuse ;
+      size_t ninuse ;
+      size_t peakinuse ;
+      unsigned long int nacquires ;
+      unsigned long int nfailed ;
+   } rng_pool_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Usage statistics of a pool. While slots are in use the numbers
+   //    are a snapshot.
+   // Variables:
+   //    nstates: number of states
+   //    ninuse: slots currently in use
+   //    peakinuse: largest number of slots in use at the same time
+   //    nacquires: successful acquisitions
+   //    nfailed: acquisitions that found no free slot
+   //    nvalues: numbers drawn through the pool routines by all slots
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_pool_stats_s {
+      size_t nstates ;
+      size_t ninuse ;
+      size_t peakinuse ;
+      unsigned long int nacquires ;
+      unsigned long int nfailed ;
+      unsigned long int nvalues ;
+   } rng_pool_stats_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Creates a pool of uniform random number states
+   // Variables:
+   //    seed: master seed of the pool
+   //    nstates: number of states, has to be positive
+   //    lower: lower bound of random numbers
+   //    upper: upper bound of random numbers
+   // Return value:
+   //    pool: pool that needs to be freed with free_rng_pool
+   /////////////////////////////////////////////////////////////////////////////
+   rng_pool_type* create_rng_pool(int seed, size_t nstates, double lower, double upper);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Frees a pool, no slot may be in use anymore
+   // Variables:
+   //    pool: pool to free
+   /////////////////////////////////////////////////////////////////////////////
+   void free_rng_pool(rng_pool_type* pool);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Takes a free slot of the pool for exclusive use, lock free
+   // Variables:
+   //    pool: pool of states
+   // Return value:
+   //    slot: acquired slot, NULL if all slots are in use
+   /////////////////////////////////////////////////////////////////////////////
+   rng_pool_slot_type* acquire_rng_pool_slot(rng_pool_type* pool);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Returns a slot to the pool, the state keeps its position
+   // Variables:
+   //    pool: pool of states
+   //    slot: slot acquired from the pool
+   /////////////////////////////////////////////////////////////////////////////
+   void release_rng_pool_slot(rng_pool_type* pool, rng_pool_slot_type* slot);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next uniform random number of a slot
+   // Variables:
+   //    slot: acquired slot
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   double next_random_uniform_pool(rng_pool_slot_type* slot);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next uniform random numbers of a slot
+   // Variables:
+   //    slot: acquired slot
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_uniform_pool(rng_pool_slot_type* slot, double* randnums, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Collects the usage statistics of a pool
+   // Variables:
+   //    pool: pool of states
+   // Return value:
+   //    stats: usage statistics
+   /////////////////////////////////////////////////////////////////////////////
+   rng_pool_stats_type get_rng_pool_stats(const rng_pool_type* pool);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
@@ -0,0 +1,362 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "MT_random.h"
+#include "MT_random_internal.h"
+#include "MT_random_serialize.h"
+
+#define SERIALMAGIC "MTRB"
+#define SERIALVERSION 1
+#define SERIALENDIAN 0x0102
+#define SERIALENDIANSWAPPED 0x0201
+
+#define CHECKSUMMULT 0x9E3779B97F4A7C15ul
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Position in a buffer while storing or restoring a state
+// Variables:
+//    pos: current position in the buffer
+//    swap: Boolean if the byte order of the buffer differs from the machine
+//    checksum: checksum of the values processed so far
+/////////////////////////////////////////////////////////////////////////////
+typedef struct serial_cursor_s {
+   unsigned char* pos ;
+   bool swap ;
+   unsigned long int checksum ;
+} serial_cursor_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Adds a value to a checksum
+// Variables:
+//    checksum: checksum so far
+//    value: value to add
+// Return value:
+//    checksum: updated checksum
+/////////////////////////////////////////////////////////////////////////////
+static inline unsigned long int add_checksum(unsigned long int checksum, unsigned long int value){
+   checksum = (checksum ^ value) * CHECKSUMMULT;
+   return checksum ^ (checksum >> 32);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reduces a checksum to the 32 bits stored in the header
+// Variables:
+//    checksum: checksum of all values
+// Return value:
+//    checksum: final 32 bit checksum
+/////////////////////////////////////////////////////////////////////////////
+static inline unsigned int finish_checksum(unsigned long int checksum){
+   return (unsigned int) ((checksum * CHECKSUMMULT) >> 32);
+}
+
+static inline void write_u32(serial_cursor_type* cursor, unsigned int value){
+   memcpy(cursor->pos, &value, 4);
+   cursor->pos += 4;
+   cursor->checksum = add_checksum(cursor->checksum, value);
+}
+
+static inline void write_u64(serial_cursor_type* cursor, unsigned long int value){
+   memcpy(cursor->pos, &value, 8);
+   cursor->pos += 8;
+   cursor->checksum = add_checksum(cursor->checksum, value);
+}
+
+static inline void write_double(serial_cursor_type* cursor, double value){
+   unsigned long int bits;
+   memcpy(&bits, &value, 8);
+   write_u64(cursor, bits);
+}
+
+static inline unsigned int read_u32(serial_cursor_type* cursor){
+   unsigned int value;
+   memcpy(&value, cursor->pos, 4);
+   cursor->pos += 4;
+   if (cursor->swap) {value = __builtin_bswap32(value);}
+   cursor->checksum = add_checksum(cursor->checksum, value);
+   return value;
+}
+
+static inline unsigned long int read_u64(serial_cursor_type* cursor){
+   unsigned long int value;
+   memcpy(&value, cursor->pos, 8);
+   cursor->pos += 8;
+   if (cursor->swap) {value = __builtin_bswap64(value);}
+   cursor->checksum = add_checksum(cursor->checksum, value);
+   return value;
+}
+
+static inline double read_double(serial_cursor_type* cursor){
+   unsigned long int bits = read_u64(cursor);
+   double value;
+   memcpy(&value, &bits, 8);
+   return value;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Writes the header of a stored state and positions the cursor
+//    behind it. The checksum is filled in by finish_header.
+// Variables:
+//    buffer: memory to hold the state
+//    tag: type tag of the state
+//    nbytes: total size of the stored state
+// Return value:
+//    cursor: cursor behind the header
+/////////////////////////////////////////////////////////////////////////////
+static serial_cursor_type write_header(void* buffer, char tag, size_t nbytes){
+   unsigned char* header = (unsigned char*) buffer;
+   unsigned short int endian = SERIALENDIAN;
+   unsigned int length = (unsigned int) (nbytes - RNG_SERIALHEADERSIZE);
+
+   memcpy(header, SERIALMAGIC, 4);
+   header[4] = (unsigned char) tag;
+   header[5] = SERIALVERSION;
+   memcpy(header+6, &endian, 2);
+   memcpy(header+8, &length, 4);
+
+   serial_cursor_type cursor = {header+RNG_SERIALHEADERSIZE, false, 0};
+   return cursor;
+}
+
+static void finish_header(void* buffer, const serial_cursor_type* cursor){
+   unsigned int checksum = finish_checksum(cursor->checksum);
+   memcpy((unsigned char*) buffer + 12, &checksum, 4);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Checks the header of a stored state and positions the cursor behind it
+// Variables:
+//    buffer: memory that holds the state
+//    nbytes: number of valid bytes in the buffer
+//    tag: expected type tag
+//    expected: expected total size of the stored state
+//    cursor: cursor behind the header
+// Return value:
+//    valid: Boolean if the header belongs to a state of the expected type
+/////////////////////////////////////////////////////////////////////////////
+static bool read_header(const void* buffer, size_t nbytes, char tag, size_t expected,
+                        serial_cursor_type* cursor){
+   const unsigned char* header = (const unsigned char*) buffer;
+   unsigned short int endian;
+   unsigned int length;
+
+   if (nbytes < expected) {return false;}
+   if (memcmp(header, SERIALMAGIC, 4) != 0) {return false;}
+   if (header[4] != (unsigned char) tag || header[5] != SERIALVERSION) {return false;}
+
+   memcpy(&endian, header+6, 2);
+   if (endian != SERIALENDIAN && endian != SERIALENDIANSWAPPED) {return false;}
+   cursor->swap = endian == SERIALENDIANSWAPPED;
+
+   memcpy(&length, header+8, 4);
+   if (cursor->swap) {length = __builtin_bswap32(length);}
+   if (length != expected - RNG_SERIALHEADERSIZE) {return false;}
+
+   cursor->pos = (unsigned char*) header + RNG_SERIALHEADERSIZE;
+   cursor->checksum = 0;
+   return true;
+}
+
+static bool check_checksum(const void* buffer, const serial_cursor_type* cursor){
+   unsigned int checksum;
+   memcpy(&checksum, (const unsigned char*) buffer + 12, 4);
+   if (cursor->swap) {checksum = __builtin_bswap32(checksum);}
+   return checksum == finish_checksum(cursor->checksum);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Writes and reads the fields of the states
+/////////////////////////////////////////////////////////////////////////////
+static void write_int_fields(serial_cursor_type* cursor, const rng_int_type* rng_int){
+   write_u32(cursor, (unsigned int) rng_int->seed);
+   write_u32(cursor, (unsigned int) rng_int->mtidx);
+
+   memcpy(cursor->pos, rng_int->mtstate, MTSTATESIZE*8);
+   cursor->pos += MTSTATESIZE*8;
+   for (int i=0; i<MTSTATESIZE; i++){
+      cursor->checksum = add_checksum(cursor->checksum, (unsigned long int) rng_int->mtstate[i]);
+   }
+}
+
+static void read_int_fields(serial_cursor_type* cursor, rng_int_type* rng_int){
+   rng_int->seed = (int) read_u32(cursor);
+   rng_int->mtidx = (int) read_u32(cursor);
+   for (int i=0; i<MTSTATESIZE; i++){
+      rng_int->mtstate[i] = (long int) read_u64(cursor);
+   }
+   reset_instrument(rng_int);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Checks the position of a restored state, the checksum does not
+//    protect against crafted buffers
+// Variables:
+//    rng_int: restored state
+// Return value:
+//    valid: Boolean if mtidx is a position the generator can hold
+/////////////////////////////////////////////////////////////////////////////
+static bool valid_int_fields(const rng_int_type* rng_int){
+   return rng_int->mtidx >= -1 && rng_int->mtidx <= NN+1;
+}
+
+static void write_uniform_fields(serial_cursor_type* cursor, const rng_uniform_type* rng_uniform){
+   write_double(cursor, rng_uniform->lower);
+   write_double(cursor, rng_uniform->upper);
+   write_int_fields(cursor, &rng_uniform->rng_int);
+}
+
+static void read_uniform_fields(serial_cursor_type* cursor, rng_uniform_type* rng_uniform){
+   rng_uniform->lower = read_double(cursor);
+   rng_uniform->upper = read_double(cursor);
+   read_int_fields(cursor, &rng_uniform->rng_int);
+}
+
+static void write_gaussian_fields(serial_cursor_type* cursor, const rng_gaussian_type* rng_gaussian){
+   write_double(cursor, rng_gaussian->mean);
+   write_double(cursor, rng_gaussian->stddev);
+   write_double(cursor, rng_gaussian->z1);
+   write_double(cursor, rng_gaussian->z2);
+   write_u64(cursor, rng_gaussian->generated ? 1ul : 0ul);
+   write_uniform_fields(cursor, &rng_gaussian->rng_uniform);
+}
+
+static void read_gaussian_fields(serial_cursor_type* cursor, rng_gaussian_type* rng_gaussian){
+   rng_gaussian->mean = read_double(cursor);
+   rng_gaussian->stddev = read_double(cursor);
+   rng_gaussian->z1 = read_double(cursor);
+   rng_gaussian->z2 = read_double(cursor);
+   rng_gaussian->generated = read_u64(cursor) != 0;
+   read_uniform_fields(cursor, &rng_gaussian->rng_uniform);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Store rng state in a buffer
+// Variables:
+//    rng_int: Random number generator state
+//    buffer: memory to hold the state
+//    capacity: size of the buffer in bytes
+// Return value:
+//    nbytes: number of bytes written, 0 if the buffer is too small
+/////////////////////////////////////////////////////////////////////////////
+size_t rng_int_serialize(const rng_int_type* rng_int, void* buffer, size_t capacity){
+   if (capacity < RNG_INT_SERIALSIZE) {return 0;}
+
+   serial_cursor_type cursor = write_header(buffer, 'I', RNG_INT_SERIALSIZE);
+   write_int_fields(&cursor, rng_int);
+   finish_header(buffer, &cursor);
+   return RNG_INT_SERIALSIZE;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Store rng state in a buffer
+// Variables:
+//    rng_uniform: Random number generator state
+//    buffer: memory to hold the state
+//    capacity: size of the buffer in bytes
+// Return value:
+//    nbytes: number of bytes written, 0 if the buffer is too small
+/////////////////////////////////////////////////////////////////////////////
+size_t rng_uniform_serialize(const rng_uniform_type* rng_uniform, void* buffer, size_t capacity){
+   if (capacity < RNG_UNIFORM_SERIALSIZE) {return 0;}
+
+   serial_cursor_type cursor = write_header(buffer, 'U', RNG_UNIFORM_SERIALSIZE);
+   write_uniform_fields(&cursor, rng_uniform);
+   finish_header(buffer, &cursor);
+   return RNG_UNIFORM_SERIALSIZE;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Store rng state in a buffer
+// Variables:
+//    rng_gaussian: Random number generator state
+//    buffer: memory to hold the state
+//    capacity: size of the buffer in bytes
+// Return value:
+//    nbytes: number of bytes written, 0 if the buffer is too small
+/////////////////////////////////////////////////////////////////////////////
+size_t rng_gaussian_serialize(const rng_gaussian_type* rng_gaussian, void* buffer, size_t capacity){
+   if (capacity < RNG_GAUSSIAN_SERIALSIZE) {return 0;}
+
+   serial_cursor_type cursor = write_header(buffer, 'G', RNG_GAUSSIAN_SERIALSIZE);
+   write_gaussian_fields(&cursor, rng_gaussian);
+   finish_header(buffer, &cursor);
+   return RNG_GAUSSIAN_SERIALSIZE;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a buffer
+//    The state is only modified if the buffer holds a valid int state.
+// Variables:
+//    rng_int: Random number generator state
+//    buffer: memory that holds the state
+//    nbytes: number of valid bytes in the buffer
+// Return value:
+//    success: Boolean if the state could be restored
+/////////////////////////////////////////////////////////////////////////////
+bool rng_int_deserialize(rng_int_type* rng_int, const void* buffer, size_t nbytes){
+   serial_cursor_type cursor;
+   rng_int_type restored;
+
+   if (!read_header(buffer, nbytes, 'I', RNG_INT_SERIALSIZE, &cursor)) {return false;}
+   read_int_fields(&cursor, &restored);
+   if (!check_checksum(buffer, &cursor) || !valid_int_fields(&restored)) {return false;}
+
+   *rng_int = restored;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a buffer
+//    The state is only modified if the buffer holds a valid uniform state.
+// Variables:
+//    rng_uniform: Random number generator state
+//    buffer: memory that holds the state
+//    nbytes: number of valid bytes in the buffer
+// Return value:
+//    success: Boolean if the state could be restored
+/////////////////////////////////////////////////////////////////////////////
+bool rng_uniform_deserialize(rng_uniform_type* rng_uniform, const void* buffer, size_t nbytes){
+   serial_cursor_type cursor;
+   rng_uniform_type restored;
+
+   if (!read_header(buffer, nbytes, 'U', RNG_UNIFORM_SERIALSIZE, &cursor)) {return false;}
+   read_uniform_fields(&cursor, &restored);
+   if (!check_checksum(buffer, &cursor) || !valid_int_fields(&restored.rng_int)) {return false;}
+
+   *rng_uniform = restored;
+   return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Restore rng state from a buffer
+//    The state is only modified if the buffer holds a valid gaussian state.
+// Variables:
+//    rng_gaussian: Random number generator state
+//    buffer: memory that holds the state
+//    nbytes: number of valid bytes in the buffer
+// Return value:
+//    success: Boolean if the state could be restored
+/////////////////////////////////////////////////////////////////////////////
+bool rng_gaussian_deserialize(rng_gaussian_type* rng_gaussian, const void* buffer, size_t nbytes){
+   serial_cursor_type cursor;
+   rng_gaussian_type restored;
+
+   if (!read_header(buffer, nbytes, 'G', RNG_GAUSSIAN_SERIALSIZE, &cursor)) {return false;}
+   read_gaussian_fields(&cursor, &restored);
+   if (!check_checksum(buffer, &cursor) || !valid_int_fields(&restored.rng_uniform.rng_int)) {return false;}
+
+   *rng_gaussian = restored;
+   return true;
+}
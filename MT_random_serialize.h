@@ -0,0 +1,128 @@
+#ifndef MT_RANDOM_SERIALIZE_H
+#define MT_RANDOM_SERIALIZE_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to store random number states in a compact binary
+   //    format in caller provided memory. Nothing is allocated.
+   //    A stored state consists of a 16 byte header followed by the fields
+   //    of the state in the byte order of the writing machine:
+   //       bytes  0- 3: magic "MTRB"
+   //       byte      4: type tag 'I', 'U' or 'G'
+   //       byte      5: format version
+   //       bytes  6- 7: 0x0102 in the byte order of the writer
+   //       bytes  8-11: length of the data following the header
+   //       bytes 12-15: checksum of the stored values
+   //    States written on a machine with the other byte order are converted
+   //    while restoring.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_serialize.h"
+   //    Store a state in a buffer of at least RNG_*_SERIALSIZE bytes:
+   //       Uniform:
+   //          nbytes = rng_uniform_serialize(&rng_stateu, buffer, capacity) ;
+   //       Gaussian:
+   //          nbytes = rng_gaussian_serialize(&rng_stateg, buffer, capacity) ;
+   //       Int / Lint:
+   //          nbytes = rng_int_serialize(&rng_statei, buffer, capacity) ;
+   //    Restore a previously stored state:
+   //       Uniform:
+   //          success = rng_uniform_deserialize(&rng_stateu, buffer, nbytes) ;
+   //       Gaussian:
+   //          success = rng_gaussian_deserialize(&rng_stateg, buffer, nbytes) ;
+   //       Int / Lint:
+   //          success = rng_int_deserialize(&rng_statei, buffer, nbytes) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stdbool.h>
+   #include <stddef.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   #define RNG_SERIALHEADERSIZE 16
+   #define RNG_INT_SERIALSIZE (RNG_SERIALHEADERSIZE+2*4+MTSTATESIZE*8)
+   #define RNG_UNIFORM_SERIALSIZE (RNG_INT_SERIALSIZE+2*8)
+   #define RNG_GAUSSIAN_SERIALSIZE (RNG_UNIFORM_SERIALSIZE+5*8)
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Store rng state in a buffer
+   // Variables:
+   //    rng_int: Random number generator state
+   //    buffer: memory to hold the state
+   //    capacity: size of the buffer in bytes
+   // Return value:
+   //    nbytes: number of bytes written, 0 if the buffer is too small
+   /////////////////////////////////////////////////////////////////////////////
+   size_t rng_int_serialize(const rng_int_type* rng_int, void* buffer, size_t capacity);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Store rng state in a buffer
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    buffer: memory to hold the state
+   //    capacity: size of the buffer in bytes
+   // Return value:
+   //    nbytes: number of bytes written, 0 if the buffer is too small
+   /////////////////////////////////////////////////////////////////////////////
+   size_t rng_uniform_serialize(const rng_uniform_type* rng_uniform, void* buffer, size_t capacity);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Store rng state in a buffer
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   //    buffer: memory to hold the state
+   //    capacity: size of the buffer in bytes
+   // Return value:
+   //    nbytes: number of bytes written, 0 if the buffer is too small
+   /////////////////////////////////////////////////////////////////////////////
+   size_t rng_gaussian_serialize(const rng_gaussian_type* rng_gaussian, void* buffer, size_t capacity);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a buffer
+   //    The state is only modified if the buffer holds a valid int state.
+   // Variables:
+   //    rng_int: Random number generator state
+   //    buffer: memory that holds the state
+   //    nbytes: number of valid bytes in the buffer
+   // Return value:
+   //    success: Boolean if the state could be restored
+   /////////////////////////////////////////////////////////////////////////////
+   bool rng_int_deserialize(rng_int_type* rng_int, const void* buffer, size_t nbytes);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a buffer
+   //    The state is only modified if the buffer holds a valid uniform state.
+   // Variables:
+   //    rng_uniform: Random number generator state
+   //    buffer: memory that holds the state
+   //    nbytes: number of valid bytes in the buffer
+   // Return value:
+   //    success: Boolean if the state could be restored
+   /////////////////////////////////////////////////////////////////////////////
+   bool rng_uniform_deserialize(rng_uniform_type* rng_uniform, const void* buffer, size_t nbytes);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Restore rng state from a buffer
+   //    The state is only modified if the buffer holds a valid gaussian state.
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   //    buffer: memory that holds the state
+   //    nbytes: number of valid bytes in the buffer
+   // Return value:
+   //    success: Boolean if the state could be restored
+   /////////////////////////////////////////////////////////////////////////////
+   bool rng_gaussian_deserialize(rng_gaussian_type* rng_gaussian, const void* buffer, size_t nbytes);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
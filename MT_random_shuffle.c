@@ -0,0 +1,548 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "MT_random.h"
+#include "MT_random_shuffle.h"
+
+// number of indices drawn at once
+#define INDEXBATCH 256
+// number of swaps the elements are prefetched ahead
+#define PREFETCHDISTANCE 16
+// number of random numbers drawn at once for the bucket labels,
+// every number gives eight labels
+#define LABELBATCH 512
+// largest element size copied in one piece
+#define SWAPCHUNK 64
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Draws a batch of unbiased indices with ranges that grow or shrink by
+//    one from index to index. The raw numbers are generated in bulk and
+//    mapped with a multiply-shift, a product with a lower half below the
+//    2^64 % range biased values is replaced by a new number.
+// Variables:
+//    rng_int: Random number generator state
+//    indices: array to hold the indices
+//    n: number of indices
+//    range: range of the first index
+//    increasing: Boolean if the ranges grow instead of shrink
+/////////////////////////////////////////////////////////////////////////////
+static void draw_indices(rng_int_type* rng_int, uint64_t* indices, size_t n,
+                         uint64_t range, bool increasing){
+   fill_random_lint(rng_int, (long int*) indices, n);
+   for (size_t i=0; i<n; i++){
+      uint64_t irange = increasing ? range+i : range-i;
+      unsigned __int128 product = (unsigned __int128) indices[i] * irange;
+      if ((uint64_t) product < irange){
+         uint64_t threshold = (0-irange) % irange;
+         while ((uint64_t) product < threshold){
+            product = (unsigned __int128) (uint64_t) next_random_lint(rng_int) * irange;
+         }
+      }
+      indices[i] = (uint64_t) (product >> 64);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Swaps two elements
+// Variables:
+//    a, b: elements to swap
+//    elem_size: size of an element in bytes
+/////////////////////////////////////////////////////////////////////////////
+static inline __attribute__((always_inline))
+void swap_elements(char* a, char* b, size_t elem_size){
+   char tmp[SWAPCHUNK];
+   while (elem_size > 0){
+      size_t nbytes = elem_size < SWAPCHUNK ? elem_size : SWAPCHUNK;
+      memcpy(tmp, a, nbytes);
+      memcpy(a, b, nbytes);
+      memcpy(b, tmp, nbytes);
+      a += nbytes;
+      b += nbytes;
+      elem_size -= nbytes;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fisher-Yates shuffle, inlined into rng_shuffle for the common element
+//    sizes. The last not yet placed element is swapped with a random one
+//    of the not yet placed elements.
+// Variables:
+//    rng_int: Random number generator state
+//    base: first element of the array
+//    n: number of elements
+//    elem_size: size of an element in bytes
+/////////////////////////////////////////////////////////////////////////////
+static inline __attribute__((always_inline))
+void shuffle_elements(rng_int_type* rng_int, char* base, size_t n, size_t elem_size){
+   uint64_t indices[INDEXBATCH];
+
+   while (n > 1){
+      size_t nbatch = n-1 < INDEXBATCH ? n-1 : INDEXBATCH;
+      draw_indices(rng_int, indices, nbatch, n, false);
+      for (size_t i=0; i<nbatch; i++){
+         if (i+PREFETCHDISTANCE < nbatch){
+            __builtin_prefetch(base + indices[i+PREFETCHDISTANCE]*elem_size, 1);
+         }
+         n--;
+         swap_elements(base + n*elem_size, base + indices[i]*elem_size, elem_size);
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Permutes an array uniformly at random with a Fisher-Yates shuffle
+// Variables:
+//    rng_int: Random number generator state
+//    base: first element of the array
+//    n: number of elements
+//    elem_size: size of an element in bytes
+/////////////////////////////////////////////////////////////////////////////
+void rng_shuffle(rng_int_type* rng_int, void* base, size_t n, size_t elem_size){
+   switch (elem_size){
+      case 4:
+         shuffle_elements(rng_int, (char*) base, n, 4);
+         break;
+      case 8:
+         shuffle_elements(rng_int, (char*) base, n, 8);
+         break;
+      case 16:
+         shuffle_elements(rng_int, (char*) base, n, 16);
+         break;
+      default:
+         shuffle_elements(rng_int, (char*) base, n, elem_size);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Moves the elements of src to dst sorted by random bucket labels.
+//    Every bucket keeps the order of src.
+// Variables:
+//    rng_int: Random number generator state
+//    src: elements to scatter
+//    dst: array to hold the elements sorted by bucket
+//    labels: array to hold the n bucket labels
+//    n: number of elements
+//    elem_size: size of an element in bytes
+//    counts: array to hold the sizes of the SHUFFLEBUCKETS buckets
+/////////////////////////////////////////////////////////////////////////////
+static inline __attribute__((always_inline))
+void scatter_elements(rng_int_type* rng_int, const char* src, char* dst,
+                      unsigned char* labels, size_t n, size_t elem_size,
+                      size_t* counts){
+   long int randnums[LABELBATCH];
+   size_t offsets[SHUFFLEBUCKETS];
+
+   memset(counts, 0, SHUFFLEBUCKETS*sizeof(size_t));
+   for (size_t i=0; i<n; i+=8*LABELBATCH){
+      size_t nlabels = n-i < 8*LABELBATCH ? n-i : 8*LABELBATCH;
+      fill_random_lint(rng_int, randnums, (nlabels+7)/8);
+      memcpy(labels+i, randnums, nlabels);
+      for (size_t j=i; j<i+nlabels; j++){
+         labels[j] &= SHUFFLEBUCKETS-1;
+         counts[labels[j]]++;
+      }
+   }
+
+   size_t offset = 0;
+   for (int ibucket=0; ibucket<SHUFFLEBUCKETS; ibucket++){
+      offsets[ibucket] = offset;
+      offset += counts[ibucket];
+   }
+
+   for (size_t i=0; i<n; i++){
+      memcpy(dst + offsets[labels[i]]*elem_size, src + i*elem_size, elem_size);
+      offsets[labels[i]]++;
+   }
+}
+
+static void scatter_buckets(rng_int_type* rng_int, const char* src, char* dst,
+                            unsigned char* labels, size_t n, size_t elem_size,
+                            size_t* counts){
+   switch (elem_size){
+      case 4:
+         scatter_elements(rng_int, src, dst, labels, n, 4, counts);
+         break;
+      case 8:
+         scatter_elements(rng_int, src, dst, labels, n, 8, counts);
+         break;
+      case 16:
+         scatter_elements(rng_int, src, dst, labels, n, 16, counts);
+         break;
+      default:
+         scatter_elements(rng_int, src, dst, labels, n, elem_size, counts);
+   }
+}
+
+static void shuffle_into(rng_int_type* rng_int, char* src, char* dst, unsigned char* labels,
+                         size_t n, size_t elem_size, int nlevels);
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Permutes an array in place with a scratch array of the same size.
+//    The buckets are permuted into the array.
+// Variables:
+//    rng_int: Random number generator state
+//    base: first element of the array
+//    scratch: scratch array
+//    labels: scratch array for n bucket labels
+//    n: number of elements
+//    elem_size: size of an element in bytes
+//    nlevels: number of times the buckets are split before they are
+//             permuted directly
+/////////////////////////////////////////////////////////////////////////////
+static void shuffle_inplace(rng_int_type* rng_int, char* base, char* scratch, unsigned char* labels,
+                            size_t n, size_t elem_size, int nlevels){
+   if (nlevels == 0 || n <= SHUFFLEBUCKETS){
+      rng_shuffle(rng_int, base, n, elem_size);
+      return;
+   }
+
+   size_t counts[SHUFFLEBUCKETS];
+   scatter_buckets(rng_int, base, scratch, labels, n, elem_size, counts);
+   size_t offset = 0;
+   for (int ibucket=0; ibucket<SHUFFLEBUCKETS; ibucket++){
+      shuffle_into(rng_int, scratch + offset*elem_size, base + offset*elem_size,
+                   labels + offset, counts[ibucket], elem_size, nlevels-1);
+      offset += counts[ibucket];
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Writes a permutation of src to dst, src is overwritten.
+//    The buckets are permuted in place in dst.
+// Variables:
+//    rng_int: Random number generator state
+//    src: elements to permute
+//    dst: array to hold the permutation
+//    labels: scratch array for n bucket labels
+//    n: number of elements
+//    elem_size: size of an element in bytes
+//    nlevels: number of times the buckets are split before they are
+//             permuted directly
+/////////////////////////////////////////////////////////////////////////////
+static void shuffle_into(rng_int_type* rng_int, char* src, char* dst, unsigned char* labels,
+                         size_t n, size_t elem_size, int nlevels){
+   if (nlevels == 0 || n <= SHUFFLEBUCKETS){
+      memcpy(dst, src, n*elem_size);
+      rng_shuffle(rng_int, dst, n, elem_size);
+      return;
+   }
+
+   size_t counts[SHUFFLEBUCKETS];
+   scatter_buckets(rng_int, src, dst, labels, n, elem_size, counts);
+   size_t offset = 0;
+   for (int ibucket=0; ibucket<SHUFFLEBUCKETS; ibucket++){
+      shuffle_inplace(rng_int, dst + offset*elem_size, src + offset*elem_size,
+                      labels + offset, counts[ibucket], elem_size, nlevels-1);
+      offset += counts[ibucket];
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Gives the size of the scratch space of rng_shuffle_blocked, a copy of
+//    the array followed by the bucket labels
+// Variables:
+//    n: number of elements
+//    elem_size: size of an element in bytes
+// Return value:
+//    nbytes: size of the scratch space in bytes
+/////////////////////////////////////////////////////////////////////////////
+size_t get_rng_shuffle_scratch_size(size_t n, size_t elem_size){
+   return n*elem_size + n;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Permutes an array uniformly at random in cache sized blocks.
+//    Every element goes to a random bucket, each bucket is permuted on its
+//    own and the buckets follow each other in a fixed order. The buckets
+//    are split again until their expected size is at most
+//    SHUFFLEBLOCKBYTES. The number of splits is fixed in advance, so
+//    buckets that are slightly larger by chance are not split once more.
+// Variables:
+//    rng_int: Random number generator state
+//    base: first element of the array
+//    n: number of elements
+//    elem_size: size of an element in bytes
+//    scratch: get_rng_shuffle_scratch_size(n, elem_size) bytes, or NULL
+/////////////////////////////////////////////////////////////////////////////
+void rng_shuffle_blocked(rng_int_type* rng_int, void* base, size_t n, size_t elem_size,
+                         void* scratch){
+   int nlevels = 0;
+   for (size_t nbytes=n*elem_size; nbytes>SHUFFLEBLOCKBYTES; nbytes/=SHUFFLEBUCKETS){
+      nlevels++;
+   }
+   if (nlevels == 0 || n <= SHUFFLEBUCKETS){
+      rng_shuffle(rng_int, base, n, elem_size);
+      return;
+   }
+
+   void* allocated = NULL;
+   if (scratch == NULL){
+      allocated = malloc(get_rng_shuffle_scratch_size(n, elem_size));
+      if (allocated == NULL){
+         fprintf(stderr, "Error in allocating scratch space for shuffling.");
+         abort();
+      }
+      scratch = allocated;
+   }
+
+   unsigned char* labels = (unsigned char*) scratch + n*elem_size;
+   shuffle_inplace(rng_int, (char*) base, (char*) scratch, labels, n, elem_size, nlevels);
+
+   free(allocated);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Type to hold the set of drawn indices of rng_sample_k, a bitmap
+//    if it is not larger than the hash table, otherwise an open
+//    addressing hash table with linear probing
+// Variables:
+//    bitmap: Boolean if the set is a bitmap
+//    mask: number of hash table entries minus one
+//    entries: bitmap words or hash table entries, UINT64_MAX marks an
+//             empty entry
+/////////////////////////////////////////////////////////////////////////////
+typedef struct index_set_s {
+   bool bitmap ;
+   uint64_t mask ;
+   uint64_t* entries ;
+} index_set_type ;
+
+static index_set_type init_index_set(uint64_t n, size_t k){
+   index_set_type index_set;
+   uint64_t nhash = 1;
+   while (nhash < 2*(uint64_t) k){
+      nhash *= 2;
+   }
+
+   // written without n+63 as n can be close to UINT64_MAX
+   uint64_t nwords = n/64 + (n%64 != 0);
+   index_set.bitmap = nwords <= nhash;
+   if (index_set.bitmap){
+      index_set.mask = 0;
+      index_set.entries = (uint64_t*) calloc(nwords, sizeof(uint64_t));
+   } else {
+      index_set.mask = nhash-1;
+      index_set.entries = (uint64_t*) malloc(nhash*sizeof(uint64_t));
+      if (index_set.entries != NULL){
+         memset(index_set.entries, 0xFF, nhash*sizeof(uint64_t));
+      }
+   }
+   if (index_set.entries == NULL){
+      fprintf(stderr, "Error in allocating index set for sampling.");
+      abort();
+   }
+   return index_set;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Adds an index to the set
+// Variables:
+//    index_set: set of indices
+//    index: index to add
+// Return value:
+//    added: Boolean if the index was not in the set
+/////////////////////////////////////////////////////////////////////////////
+static inline bool add_index_set(index_set_type* index_set, uint64_t index){
+   if (index_set->bitmap){
+      uint64_t bit = 1ul << (index%64);
+      bool added = !(index_set->entries[index/64] & bit);
+      index_set->entries[index/64] |= bit;
+      return added;
+   }
+
+   uint64_t slot = (index * 0x9E3779B97F4A7C15ul) >> 32;
+   while (true){
+      slot &= index_set->mask;
+      if (index_set->entries[slot] == index) {return false;}
+      if (index_set->entries[slot] == UINT64_MAX){
+         index_set->entries[slot] = index;
+         return true;
+      }
+      slot++;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Draws k distinct indices in [0,n) with Floyd's algorithm. Index j of
+//    n-k..n-1 draws t in [0,j] and takes t, or j if t was taken already.
+// Variables:
+//    rng_int: Random number generator state
+//    n: number of indices to choose from
+//    k: number of indices to draw, at most n
+//    samples: array to hold the k indices
+/////////////////////////////////////////////////////////////////////////////
+void rng_sample_k(rng_int_type* rng_int, uint64_t n, size_t k, uint64_t* samples){
+   if (k > n){
+      fprintf(stderr, "Error in sampling %zu of %llu indices.", k, (unsigned long long) n);
+      abort();
+   }
+   if (k == 0) {return;}
+
+   index_set_type index_set = init_index_set(n, k);
+   uint64_t indices[INDEXBATCH];
+
+   size_t isample = 0;
+   while (isample < k){
+      size_t nbatch = k-isample < INDEXBATCH ? k-isample : INDEXBATCH;
+      draw_indices(rng_int, indices, nbatch, n-k+isample+1, true);
+      for (size_t i=0; i<nbatch; i++){
+         uint64_t j = n-k+isample;
+         if (add_index_set(&index_set, indices[i])){
+            samples[isample] = indices[i];
+         } else {
+            add_index_set(&index_set, j);
+            samples[isample] = j;
+         }
+         isample++;
+      }
+   }
+
+   free(index_set.entries);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Initializes an empty reservoir
+// Variables:
+//    k: number of samples to keep, positive
+//    elem_size: size of an element in bytes
+// Return value:
+//    reservoir: reservoir that needs to be freed with free_rng_reservoir
+/////////////////////////////////////////////////////////////////////////////
+rng_reservoir_type init_rng_reservoir(size_t k, size_t elem_size){
+   rng_reservoir_type reservoir;
+
+   if (k == 0 || elem_size == 0){
+      fprintf(stderr, "Error in initializing reservoir of %zu elements of %zu bytes.", k, elem_size);
+      abort();
+   }
+
+   reservoir.k = k;
+   reservoir.elem_size = elem_size;
+   reservoir.nseen = 0;
+   reservoir.nextidx = 0;
+   reservoir.w = 0.0;
+   reservoir.samples = malloc(k*elem_size);
+   if (reservoir.samples == NULL){
+      fprintf(stderr, "Error in allocating reservoir.");
+      abort();
+   }
+   return reservoir;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates a uniform random number in (0,1)
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+static inline double next_open_uniform(rng_int_type* rng_int){
+   uint64_t randnum = (uint64_t) next_random_lint(rng_int);
+   return ((double) (randnum >> 11) + 0.5) * (1.0/9007199254740992.0);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Updates the largest of k uniform numbers and moves the index of the
+//    next element to take by a geometrically distributed number of skipped
+//    elements. The index saturates at UINT64_MAX.
+// Variables:
+//    rng_int: Random number generator state
+//    reservoir: reservoir to update
+/////////////////////////////////////////////////////////////////////////////
+static void advance_reservoir(rng_int_type* rng_int, rng_reservoir_type* reservoir){
+   reservoir->w *= exp(log(next_open_uniform(rng_int)) / (double) reservoir->k);
+   double skip = floor(log(next_open_uniform(rng_int)) / log1p(-reservoir->w));
+   if (skip < (double) (UINT64_MAX - reservoir->nseen)){
+      reservoir->nextidx = reservoir->nseen + (uint64_t) skip;
+   } else {
+      reservoir->nextidx = UINT64_MAX;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Feeds the next elements of the stream to a reservoir. The first k
+//    elements are kept, afterwards the elements at nextidx replace a
+//    random sample.
+// Variables:
+//    rng_int: Random number generator state
+//    reservoir: reservoir to update
+//    elements: first of the next elements of the stream
+//    n: number of elements
+/////////////////////////////////////////////////////////////////////////////
+void add_rng_reservoir(rng_int_type* rng_int, rng_reservoir_type* reservoir,
+                       const void* elements, size_t n){
+   const char* element = (const char*) elements;
+   char* samples = (char*) reservoir->samples;
+   size_t elem_size = reservoir->elem_size;
+
+   while (n > 0 && reservoir->nseen < reservoir->k){
+      memcpy(samples + reservoir->nseen*elem_size, element, elem_size);
+      reservoir->nseen++;
+      element += elem_size;
+      n--;
+      if (reservoir->nseen == reservoir->k){
+         reservoir->w = 1.0;
+         advance_reservoir(rng_int, reservoir);
+      }
+   }
+
+   while (n > 0){
+      uint64_t nskip = reservoir->nextidx - reservoir->nseen;
+      if (nskip >= n){
+         reservoir->nseen += n;
+         return;
+      }
+      element += nskip*elem_size;
+      n -= nskip;
+
+      uint64_t isample = next_random_range(rng_int, reservoir->k);
+      memcpy(samples + isample*elem_size, element, elem_size);
+      reservoir->nseen = reservoir->nextidx + 1;
+      element += elem_size;
+      n--;
+      advance_reservoir(rng_int, reservoir);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Gives the number of elements in a reservoir
+// Variables:
+//    reservoir: reservoir
+// Return value:
+//    nsamples: min(k, number of elements of the stream)
+/////////////////////////////////////////////////////////////////////////////
+size_t get_rng_reservoir_size(const rng_reservoir_type* reservoir){
+   return reservoir->nseen < reservoir->k ? (size_t) reservoir->nseen : reservoir->k;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Frees the memory of a reservoir
+// Variables:
+//    reservoir: reservoir to free
+/////////////////////////////////////////////////////////////////////////////
+void free_rng_reservoir(rng_reservoir_type* reservoir){
+   free(reservoir->samples);
+   reservoir->samples = NULL;
+   reservoir->k = 0;
+   reservoir->nseen = 0;
+}
@@ -0,0 +1,169 @@
+#ifndef MT_RANDOM_SHUFFLE_H
+#define MT_RANDOM_SHUFFLE_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to permute arrays and to draw samples without
+   //    replacement. The indices are drawn in batches from the int random
+   //    number state and mapped to their range with the unbiased
+   //    multiply-shift of next_random_range.
+   //    rng_shuffle is a Fisher-Yates shuffle that prefetches the elements
+   //    of the coming swaps. rng_shuffle_blocked is meant for arrays much
+   //    larger than the cache: the elements are scattered into SHUFFLEBUCKETS
+   //    random buckets, which are shuffled one after another (Rao-Sandelius).
+   //    rng_sample_k draws k distinct indices with Floyd's algorithm in O(k).
+   //    The reservoir keeps a uniform sample of k elements of a stream of
+   //    unknown length and skips the elements it does not take (Li 1994,
+   //    algorithm L).
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_shuffle.h"
+   //    Permute an array of n elements of elem_size bytes:
+   //       rng_shuffle(&rng_statei, array, n, elem_size) ;
+   //    Permute an array much larger than the cache, with scratch space of
+   //    get_rng_shuffle_scratch_size(n, elem_size) bytes or NULL:
+   //       rng_shuffle_blocked(&rng_statei, array, n, elem_size, scratch) ;
+   //    Draw k distinct indices in [0,n):
+   //       rng_sample_k(&rng_statei, n, k, samples) ;
+   //    Keep a sample of k elements of a stream:
+   //       reservoir = init_rng_reservoir(k, elem_size) ;
+   //       add_rng_reservoir(&rng_statei, &reservoir, elements, nelements) ;
+   //       nsamples = get_rng_reservoir_size(&reservoir) ;
+   //       free_rng_reservoir(&reservoir) ;
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include <stdint.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   // number of buckets of rng_shuffle_blocked, a power of two of at most
+   // 256. More buckets save passes over large arrays, but the scatter
+   // into them slows down once their write streams exceed what the cache
+   // and the TLB keep track of.
+   #define SHUFFLEBUCKETS 32
+   // arrays up to this size are shuffled directly by rng_shuffle_blocked,
+   // buckets up to twice this size
+   #define SHUFFLEBLOCKBYTES (256*1024)
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Type to hold a reservoir sample
+   // Variables:
+   //    k: number of samples to keep
+   //    elem_size: size of an element in bytes
+   //    nseen: number of elements of the stream so far
+   //    nextidx: index in the stream of the next element to take
+   //    w: largest of k uniform numbers, decides the length of the skips
+   //    samples: the kept elements, min(k,nseen) of them
+   /////////////////////////////////////////////////////////////////////////////
+   typedef struct rng_reservoir_s {
+      size_t k ;
+      size_t elem_size ;
+      uint64_t nseen ;
+      uint64_t nextidx ;
+      double w ;
+      void* samples ;
+   } rng_reservoir_type ;
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Permutes an array uniformly at random with a Fisher-Yates shuffle
+   // Variables:
+   //    rng_int: Random number generator state
+   //    base: first element of the array
+   //    n: number of elements
+   //    elem_size: size of an element in bytes
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_shuffle(rng_int_type* rng_int, void* base, size_t n, size_t elem_size);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Gives the size of the scratch space of rng_shuffle_blocked
+   // Variables:
+   //    n: number of elements
+   //    elem_size: size of an element in bytes
+   // Return value:
+   //    nbytes: size of the scratch space in bytes
+   /////////////////////////////////////////////////////////////////////////////
+   size_t get_rng_shuffle_scratch_size(size_t n, size_t elem_size);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Permutes an array uniformly at random in cache sized blocks.
+   //    Needs scratch space for a copy of the array and a byte per element.
+   //    Reusing the scratch space for repeated shuffles saves touching
+   //    fresh memory every time. Arrays of at most SHUFFLEBLOCKBYTES are
+   //    permuted with rng_shuffle.
+   // Variables:
+   //    rng_int: Random number generator state
+   //    base: first element of the array
+   //    n: number of elements
+   //    elem_size: size of an element in bytes
+   //    scratch: get_rng_shuffle_scratch_size(n, elem_size) bytes, or NULL
+   //             to allocate them for this call
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_shuffle_blocked(rng_int_type* rng_int, void* base, size_t n, size_t elem_size,
+                            void* scratch);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Draws k distinct indices in [0,n), every subset is equally likely.
+   //    The order of the indices is not random, shuffle them if needed.
+   // Variables:
+   //    rng_int: Random number generator state
+   //    n: number of indices to choose from
+   //    k: number of indices to draw, at most n
+   //    samples: array to hold the k indices
+   /////////////////////////////////////////////////////////////////////////////
+   void rng_sample_k(rng_int_type* rng_int, uint64_t n, size_t k, uint64_t* samples);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Initializes an empty reservoir
+   // Variables:
+   //    k: number of samples to keep, positive
+   //    elem_size: size of an element in bytes
+   // Return value:
+   //    reservoir: reservoir that needs to be freed with free_rng_reservoir
+   /////////////////////////////////////////////////////////////////////////////
+   rng_reservoir_type init_rng_reservoir(size_t k, size_t elem_size);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Feeds the next elements of the stream to a reservoir. Only the
+   //    taken elements cost random numbers.
+   // Variables:
+   //    rng_int: Random number generator state
+   //    reservoir: reservoir to update
+   //    elements: first of the next elements of the stream
+   //    n: number of elements
+   /////////////////////////////////////////////////////////////////////////////
+   void add_rng_reservoir(rng_int_type* rng_int, rng_reservoir_type* reservoir,
+                          const void* elements, size_t n);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Gives the number of elements in a reservoir
+   // Variables:
+   //    reservoir: reservoir
+   // Return value:
+   //    nsamples: min(k, number of elements of the stream)
+   /////////////////////////////////////////////////////////////////////////////
+   size_t get_rng_reservoir_size(const rng_reservoir_type* reservoir);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Frees the memory of a reservoir
+   // Variables:
+   //    reservoir: reservoir to free
+   /////////////////////////////////////////////////////////////////////////////
+   void free_rng_reservoir(rng_reservoir_type* reservoir);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif
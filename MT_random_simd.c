@@ -0,0 +1,782 @@
+#include <stddef.h>
+#include <math.h>
+#include "MT_random_internal.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define MT_RANDOM_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#define MATRIXA 0xB5026F5AA96619E9
+
+// log(x) after fdlibm, x = 2^k (1+f) with 1+f in [sqrt(2)/2, sqrt(2))
+#define LN2HI 6.93147180369123816490e-01
+#define LN2LO 1.90821492927058770002e-10
+#define LG1 6.666666666666735130e-01
+#define LG2 3.999999999940941908e-01
+#define LG3 2.857142874366239149e-01
+#define LG4 2.222219843214978396e-01
+#define LG5 1.818357216161805012e-01
+#define LG6 1.531383769920937332e-01
+#define LG7 1.479819860511658591e-01
+#define LOGHIGHSHIFT (0x3ff00000 - 0x3fe6a09e)
+#define LOGHIGHSQRTHALF 0x3fe6a09e
+#define LOGEXPBIAS 0x4330000000000000
+#define LOGEXPOFFSET (4503599627370496.0 + 1023.0)
+
+// sin(x) and cos(x) after fdlibm for |x| <= pi/4
+#define SIN1 -1.66666666666666324348e-01
+#define SIN2  8.33333333332248946124e-03
+#define SIN3 -1.98412698298579493134e-04
+#define SIN4  2.75573137070700676789e-06
+#define SIN5 -2.50507602534068634195e-08
+#define SIN6  1.58969099521155010221e-10
+#define COS1  4.16666666666666019037e-02
+#define COS2 -1.38888888888741095749e-03
+#define COS3  2.48015872894767294178e-05
+#define COS4 -2.75573143513906633035e-07
+#define COS5  2.08757232129817482790e-09
+#define COS6 -1.13596475577881948265e-11
+#define TWOPI 6.28318530717958647692528676655900559
+// adding 1.5*2^52 rounds to an integer that ends up in the lowest bits
+#define ROUNDMAGIC 6755399441055744.0
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Computes a single new element of the mersenne twister state
+// Variables:
+//    mtstate: State of the mersenne twister
+//    i: index of the element to update
+//    ip1: index of the following element
+//    ipm: index of the element MM positions further
+/////////////////////////////////////////////////////////////////////////////
+static inline void twist_mtstate_element(long int* mtstate, int i, int ip1, int ipm){
+   unsigned long int rng = (mtstate[i] & UM) ^ (mtstate[ip1] & LM);
+   mtstate[i] = (mtstate[ipm] ^ (rng>>1)) ^ (mag[(rng& 1)]) ;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in a mersenne twister state
+// Variables:
+//    mtstate: State of the mersenne twister
+/////////////////////////////////////////////////////////////////////////////
+static void regenerate_mtstate_scalar(long int* mtstate){
+   for (int i=0; i<NN-MM; i++) {
+      twist_mtstate_element(mtstate, i, i+1, i+MM);
+   }
+   for (int i=NN-MM; i<NN-1; i++) {
+      twist_mtstate_element(mtstate, i, i+1, i+MM-NN);
+   }
+   twist_mtstate_element(mtstate, NN-1, 0, MM-1);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Computes the elements begin to end-1 of the mersenne twister state in
+//    ascending order. The elements used for element i are found at
+//    i+nextoff and i+faroff.
+// Variables:
+//    mtstate: State of the mersenne twister
+//    begin: first element to update
+//    end: element behind the last element to update
+//    nextoff: offset of the following element
+//    faroff: offset of the element MM positions further
+/////////////////////////////////////////////////////////////////////////////
+static void twist_mtstate_range_scalar(long int* mtstate, long int begin, long int end,
+                                       long int nextoff, long int faroff){
+   for (long int i=begin; i<end; i++){
+      unsigned long int rng = (mtstate[i] & UM) ^ (mtstate[i+nextoff] & LM);
+      mtstate[i] = (mtstate[i+faroff] ^ (rng>>1)) ^ (mag[(rng& 1)]) ;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in nlanes interleaved mersenne
+//    twister states, where element i of lane l is stored at i*nlanes+l.
+//    Every row of nlanes elements only depends on other rows, so the
+//    states are updated as one flat array.
+// Variables:
+//    mtstate: interleaved states of the mersenne twisters
+//    nlanes: number of interleaved states
+/////////////////////////////////////////////////////////////////////////////
+static void regenerate_mtstate_lanes_scalar(long int* mtstate, int nlanes){
+   long int n = nlanes;
+   twist_mtstate_range_scalar(mtstate, 0, (NN-MM)*n, n, MM*n);
+   twist_mtstate_range_scalar(mtstate, (NN-MM)*n, (NN-1)*n, n, (MM-NN)*n);
+   twist_mtstate_range_scalar(mtstate, (NN-1)*n, NN*n, -(NN-1)*n, (MM-NN)*n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Tempers a consecutive part of a mersenne twister state
+// Variables:
+//    mtstate: first element of the state to temper
+//    randnums: array to hold the random numbers
+//    n: number of elements to temper
+/////////////////////////////////////////////////////////////////////////////
+static void temper_mtstate_scalar(const long int* mtstate, long int* randnums, size_t n){
+   for (size_t i=0; i<n; i++){
+      randnums[i] = (long int) temper_rng_int(mtstate[i]);
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Reinterprets the bits of a double as integer and vice versa
+/////////////////////////////////////////////////////////////////////////////
+static inline unsigned long int double_bits(double x){
+   union {double d; unsigned long int i;} u = {x};
+   return u.i;
+}
+static inline double bits_double(unsigned long int i){
+   union {unsigned long int i; double d;} u = {i};
+   return u.d;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Tempers a consecutive part of a mersenne twister state and turns the
+//    upper 52 bits of every number into a double x in [1,2) by setting the
+//    exponent bits, the result is x*scale+offset
+// Variables:
+//    mtstate: first element of the state to convert
+//    randnums: array to hold the random numbers
+//    n: number of elements to convert
+//    onebits: exponent bits of 1.0, optionally with the lowest mantissa bit
+//    scale: factor of x
+//    offset: summand of x*scale
+/////////////////////////////////////////////////////////////////////////////
+static void uniform_mtstate_scalar(const long int* mtstate, double* randnums, size_t n,
+                                   unsigned long int onebits, double scale, double offset){
+   for (size_t i=0; i<n; i++){
+      double x = bits_double((temper_rng_int(mtstate[i])>>12) | onebits);
+      randnums[i] = x*scale + offset;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Performs the Box-Muller transform on pairs of uniform random numbers
+//    with polynomial approximations of log, sin and cos. The arithmetic is
+//    the same as in the vector kernels, so all kernels give identical bits.
+//    Pairs with u1 == 0 give meaningless results and have to be skipped.
+// Variables:
+//    uniforms: npairs pairs (u1, u2) with u1 in (0,1] and u2 in [0,1]
+//    gaussians: array to hold npairs pairs (z1, z2)
+//    npairs: number of pairs
+/////////////////////////////////////////////////////////////////////////////
+static void box_muller_pairs_scalar(const double* uniforms, double* gaussians, size_t npairs){
+   for (size_t i=0; i<npairs; i++){
+      double u1 = uniforms[2*i];
+      double u2 = uniforms[2*i+1];
+
+      // log(u1)
+      unsigned long int bits = double_bits(u1);
+      unsigned long int high = (bits >> 32) + LOGHIGHSHIFT;
+      double dk = bits_double((high >> 20) | LOGEXPBIAS) - LOGEXPOFFSET;
+      high = (high & 0x000fffff) + LOGHIGHSQRTHALF;
+      double f = bits_double((high << 32) | (bits & 0xffffffff)) - 1.0;
+      double hfsq = 0.5*f*f;
+      double s = f/(2.0+f);
+      double z = s*s;
+      double w = z*z;
+      double t1 = w*(LG2+w*(LG4+w*LG6));
+      double t2 = z*(LG1+w*(LG3+w*(LG5+w*LG7)));
+      double logu1 = s*(hfsq+(t2+t1)) + dk*LN2LO - hfsq + f + dk*LN2HI;
+
+      double radius = sqrt(-2.0*logu1);
+
+      // 2 pi u2 = 2 pi (u2-q/4) + q pi/2 with an exact reduction
+      double rounded = 4.0*u2 + ROUNDMAGIC;
+      unsigned long int quadrant = double_bits(rounded);
+      double x = TWOPI*(u2 - 0.25*(rounded - ROUNDMAGIC));
+      z = x*x;
+      w = z*z;
+      double r = SIN2 + z*(SIN3 + z*SIN4) + z*w*(SIN5 + z*SIN6);
+      double sinx = x + z*x*(SIN1 + z*r);
+      r = z*(COS1+z*(COS2+z*COS3)) + w*w*(COS4+z*(COS5+z*COS6));
+      double hz = 0.5*z;
+      w = 1.0-hz;
+      double cosx = w + (((1.0-w)-hz) + z*r);
+
+      double c = (quadrant & 1ul) ? sinx : cosx;
+      double sn = (quadrant & 1ul) ? cosx : sinx;
+      c = bits_double(double_bits(c) ^ (((quadrant+1ul) & 2ul) << 62));
+      sn = bits_double(double_bits(sn) ^ ((quadrant & 2ul) << 62));
+
+      gaussians[2*i] = radius*c;
+      gaussians[2*i+1] = radius*sn;
+   }
+}
+
+#ifdef MT_RANDOM_X86_KERNELS
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX2 version of regenerate_mtstate_scalar, four elements at a time.
+//    The elements i+1 and i+MM are read before they are overwritten,
+//    and in the second pass the elements i+MM-NN are already updated,
+//    exactly as in the scalar loops.
+// Variables:
+//    mtstate: State of the mersenne twister
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static void regenerate_mtstate_avx2(long int* mtstate){
+   const __m256i um = _mm256_set1_epi64x((long long) UM);
+   const __m256i lm = _mm256_set1_epi64x((long long) LM);
+   const __m256i one = _mm256_set1_epi64x(1);
+   const __m256i matrixa = _mm256_set1_epi64x((long long) MATRIXA);
+   const __m256i zero = _mm256_setzero_si256();
+
+   int i = 0;
+   for (; i+4<=NN-MM; i+=4){
+      __m256i cur = _mm256_loadu_si256((const __m256i*) (mtstate+i));
+      __m256i next = _mm256_loadu_si256((const __m256i*) (mtstate+i+1));
+      __m256i far = _mm256_loadu_si256((const __m256i*) (mtstate+i+MM));
+      __m256i rng = _mm256_or_si256(_mm256_and_si256(cur, um), _mm256_and_si256(next, lm));
+      __m256i mask = _mm256_sub_epi64(zero, _mm256_and_si256(rng, one));
+      far = _mm256_xor_si256(far, _mm256_srli_epi64(rng, 1));
+      far = _mm256_xor_si256(far, _mm256_and_si256(mask, matrixa));
+      _mm256_storeu_si256((__m256i*) (mtstate+i), far);
+   }
+   for (; i<NN-MM; i++){
+      twist_mtstate_element(mtstate, i, i+1, i+MM);
+   }
+
+   for (; i+4<=NN-1; i+=4){
+      __m256i cur = _mm256_loadu_si256((const __m256i*) (mtstate+i));
+      __m256i next = _mm256_loadu_si256((const __m256i*) (mtstate+i+1));
+      __m256i far = _mm256_loadu_si256((const __m256i*) (mtstate+i+MM-NN));
+      __m256i rng = _mm256_or_si256(_mm256_and_si256(cur, um), _mm256_and_si256(next, lm));
+      __m256i mask = _mm256_sub_epi64(zero, _mm256_and_si256(rng, one));
+      far = _mm256_xor_si256(far, _mm256_srli_epi64(rng, 1));
+      far = _mm256_xor_si256(far, _mm256_and_si256(mask, matrixa));
+      _mm256_storeu_si256((__m256i*) (mtstate+i), far);
+   }
+   for (; i<NN-1; i++){
+      twist_mtstate_element(mtstate, i, i+1, i+MM-NN);
+   }
+
+   twist_mtstate_element(mtstate, NN-1, 0, MM-1);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX2 version of temper_mtstate_scalar
+// Variables:
+//    mtstate: first element of the state to temper
+//    randnums: array to hold the random numbers
+//    n: number of elements to temper
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static void temper_mtstate_avx2(const long int* mtstate, long int* randnums, size_t n){
+   const __m256i mask1 = _mm256_set1_epi64x((long long) 0x5555555555555555);
+   const __m256i mask2 = _mm256_set1_epi64x((long long) 0x71d67fffeda60000);
+   const __m256i mask3 = _mm256_set1_epi64x((long long) 0xfff7eee000000000);
+
+   size_t i = 0;
+   for (; i+4<=n; i+=4){
+      __m256i rng = _mm256_loadu_si256((const __m256i*) (mtstate+i));
+      rng = _mm256_xor_si256(rng, _mm256_and_si256(_mm256_srli_epi64(rng, 29), mask1));
+      rng = _mm256_xor_si256(rng, _mm256_and_si256(_mm256_slli_epi64(rng, 17), mask2));
+      rng = _mm256_xor_si256(rng, _mm256_and_si256(_mm256_slli_epi64(rng, 37), mask3));
+      rng = _mm256_xor_si256(rng, _mm256_srli_epi64(rng, 43));
+      _mm256_storeu_si256((__m256i*) (randnums+i), rng);
+   }
+   temper_mtstate_scalar(mtstate+i, randnums+i, n-i);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX2 version of uniform_mtstate_scalar
+// Variables:
+//    mtstate: first element of the state to convert
+//    randnums: array to hold the random numbers
+//    n: number of elements to convert
+//    onebits: exponent bits of 1.0, optionally with the lowest mantissa bit
+//    scale: factor of x
+//    offset: summand of x*scale
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static void uniform_mtstate_avx2(const long int* mtstate, double* randnums, size_t n,
+                                 unsigned long int onebits, double scale, double offset){
+   const __m256i mask1 = _mm256_set1_epi64x((long long) 0x5555555555555555);
+   const __m256i mask2 = _mm256_set1_epi64x((long long) 0x71d67fffeda60000);
+   const __m256i mask3 = _mm256_set1_epi64x((long long) 0xfff7eee000000000);
+   const __m256i one = _mm256_set1_epi64x((long long) onebits);
+   const __m256d vscale = _mm256_set1_pd(scale);
+   const __m256d voffset = _mm256_set1_pd(offset);
+
+   size_t i = 0;
+   for (; i+4<=n; i+=4){
+      __m256i rng = _mm256_loadu_si256((const __m256i*) (mtstate+i));
+      rng = _mm256_xor_si256(rng, _mm256_and_si256(_mm256_srli_epi64(rng, 29), mask1));
+      rng = _mm256_xor_si256(rng, _mm256_and_si256(_mm256_slli_epi64(rng, 17), mask2));
+      rng = _mm256_xor_si256(rng, _mm256_and_si256(_mm256_slli_epi64(rng, 37), mask3));
+      rng = _mm256_xor_si256(rng, _mm256_srli_epi64(rng, 43));
+      __m256d x = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(rng, 12), one));
+      _mm256_storeu_pd(randnums+i, _mm256_add_pd(_mm256_mul_pd(x, vscale), voffset));
+   }
+   uniform_mtstate_scalar(mtstate+i, randnums+i, n-i, onebits, scale, offset);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX2 version of twist_mtstate_range_scalar, four elements at a time.
+//    All elements of a vector are loaded before it is stored, so this
+//    matches the scalar order as long as |faroff| >= 4.
+// Variables:
+//    mtstate: State of the mersenne twister
+//    begin: first element to update
+//    end: element behind the last element to update
+//    nextoff: offset of the following element
+//    faroff: offset of the element MM positions further
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static void twist_mtstate_range_avx2(long int* mtstate, long int begin, long int end,
+                                     long int nextoff, long int faroff){
+   const __m256i um = _mm256_set1_epi64x((long long) UM);
+   const __m256i lm = _mm256_set1_epi64x((long long) LM);
+   const __m256i one = _mm256_set1_epi64x(1);
+   const __m256i matrixa = _mm256_set1_epi64x((long long) MATRIXA);
+   const __m256i zero = _mm256_setzero_si256();
+
+   long int i = begin;
+   for (; i+4<=end; i+=4){
+      __m256i cur = _mm256_loadu_si256((const __m256i*) (mtstate+i));
+      __m256i next = _mm256_loadu_si256((const __m256i*) (mtstate+i+nextoff));
+      __m256i far = _mm256_loadu_si256((const __m256i*) (mtstate+i+faroff));
+      __m256i rng = _mm256_or_si256(_mm256_and_si256(cur, um), _mm256_and_si256(next, lm));
+      __m256i mask = _mm256_sub_epi64(zero, _mm256_and_si256(rng, one));
+      far = _mm256_xor_si256(far, _mm256_srli_epi64(rng, 1));
+      far = _mm256_xor_si256(far, _mm256_and_si256(mask, matrixa));
+      _mm256_storeu_si256((__m256i*) (mtstate+i), far);
+   }
+   twist_mtstate_range_scalar(mtstate, i, end, nextoff, faroff);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX2 version of regenerate_mtstate_lanes_scalar
+// Variables:
+//    mtstate: interleaved states of the mersenne twisters
+//    nlanes: number of interleaved states
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static void regenerate_mtstate_lanes_avx2(long int* mtstate, int nlanes){
+   long int n = nlanes;
+   twist_mtstate_range_avx2(mtstate, 0, (NN-MM)*n, n, MM*n);
+   twist_mtstate_range_avx2(mtstate, (NN-MM)*n, (NN-1)*n, n, (MM-NN)*n);
+   twist_mtstate_range_avx2(mtstate, (NN-1)*n, NN*n, -(NN-1)*n, (MM-NN)*n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX-512 version of regenerate_mtstate_scalar, eight elements at a time
+// Variables:
+//    mtstate: State of the mersenne twister
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx512f")))
+static void regenerate_mtstate_avx512(long int* mtstate){
+   const __m512i um = _mm512_set1_epi64((long long) UM);
+   const __m512i lm = _mm512_set1_epi64((long long) LM);
+   const __m512i one = _mm512_set1_epi64(1);
+   const __m512i matrixa = _mm512_set1_epi64((long long) MATRIXA);
+   const __m512i zero = _mm512_setzero_si512();
+
+   int i = 0;
+   for (; i+8<=NN-MM; i+=8){
+      __m512i cur = _mm512_loadu_si512((const void*) (mtstate+i));
+      __m512i next = _mm512_loadu_si512((const void*) (mtstate+i+1));
+      __m512i far = _mm512_loadu_si512((const void*) (mtstate+i+MM));
+      __m512i rng = _mm512_or_si512(_mm512_and_si512(cur, um), _mm512_and_si512(next, lm));
+      __m512i mask = _mm512_sub_epi64(zero, _mm512_and_si512(rng, one));
+      far = _mm512_xor_si512(far, _mm512_srli_epi64(rng, 1));
+      far = _mm512_xor_si512(far, _mm512_and_si512(mask, matrixa));
+      _mm512_storeu_si512((void*) (mtstate+i), far);
+   }
+   for (; i<NN-MM; i++){
+      twist_mtstate_element(mtstate, i, i+1, i+MM);
+   }
+
+   for (; i+8<=NN-1; i+=8){
+      __m512i cur = _mm512_loadu_si512((const void*) (mtstate+i));
+      __m512i next = _mm512_loadu_si512((const void*) (mtstate+i+1));
+      __m512i far = _mm512_loadu_si512((const void*) (mtstate+i+MM-NN));
+      __m512i rng = _mm512_or_si512(_mm512_and_si512(cur, um), _mm512_and_si512(next, lm));
+      __m512i mask = _mm512_sub_epi64(zero, _mm512_and_si512(rng, one));
+      far = _mm512_xor_si512(far, _mm512_srli_epi64(rng, 1));
+      far = _mm512_xor_si512(far, _mm512_and_si512(mask, matrixa));
+      _mm512_storeu_si512((void*) (mtstate+i), far);
+   }
+   for (; i<NN-1; i++){
+      twist_mtstate_element(mtstate, i, i+1, i+MM-NN);
+   }
+
+   twist_mtstate_element(mtstate, NN-1, 0, MM-1);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX-512 version of twist_mtstate_range_scalar, eight elements at a time
+// Variables:
+//    mtstate: State of the mersenne twister
+//    begin: first element to update
+//    end: element behind the last element to update
+//    nextoff: offset of the following element
+//    faroff: offset of the element MM positions further
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx512f")))
+static void twist_mtstate_range_avx512(long int* mtstate, long int begin, long int end,
+                                       long int nextoff, long int faroff){
+   const __m512i um = _mm512_set1_epi64((long long) UM);
+   const __m512i lm = _mm512_set1_epi64((long long) LM);
+   const __m512i one = _mm512_set1_epi64(1);
+   const __m512i matrixa = _mm512_set1_epi64((long long) MATRIXA);
+   const __m512i zero = _mm512_setzero_si512();
+
+   long int i = begin;
+   for (; i+8<=end; i+=8){
+      __m512i cur = _mm512_loadu_si512((const void*) (mtstate+i));
+      __m512i next = _mm512_loadu_si512((const void*) (mtstate+i+nextoff));
+      __m512i far = _mm512_loadu_si512((const void*) (mtstate+i+faroff));
+      __m512i rng = _mm512_or_si512(_mm512_and_si512(cur, um), _mm512_and_si512(next, lm));
+      __m512i mask = _mm512_sub_epi64(zero, _mm512_and_si512(rng, one));
+      far = _mm512_xor_si512(far, _mm512_srli_epi64(rng, 1));
+      far = _mm512_xor_si512(far, _mm512_and_si512(mask, matrixa));
+      _mm512_storeu_si512((void*) (mtstate+i), far);
+   }
+   twist_mtstate_range_scalar(mtstate, i, end, nextoff, faroff);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX-512 version of regenerate_mtstate_lanes_scalar
+// Variables:
+//    mtstate: interleaved states of the mersenne twisters
+//    nlanes: number of interleaved states
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx512f")))
+static void regenerate_mtstate_lanes_avx512(long int* mtstate, int nlanes){
+   long int n = nlanes;
+   twist_mtstate_range_avx512(mtstate, 0, (NN-MM)*n, n, MM*n);
+   twist_mtstate_range_avx512(mtstate, (NN-MM)*n, (NN-1)*n, n, (MM-NN)*n);
+   twist_mtstate_range_avx512(mtstate, (NN-1)*n, NN*n, -(NN-1)*n, (MM-NN)*n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX-512 version of temper_mtstate_scalar
+// Variables:
+//    mtstate: first element of the state to temper
+//    randnums: array to hold the random numbers
+//    n: number of elements to temper
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx512f")))
+static void temper_mtstate_avx512(const long int* mtstate, long int* randnums, size_t n){
+   const __m512i mask1 = _mm512_set1_epi64((long long) 0x5555555555555555);
+   const __m512i mask2 = _mm512_set1_epi64((long long) 0x71d67fffeda60000);
+   const __m512i mask3 = _mm512_set1_epi64((long long) 0xfff7eee000000000);
+
+   size_t i = 0;
+   for (; i+8<=n; i+=8){
+      __m512i rng = _mm512_loadu_si512((const void*) (mtstate+i));
+      rng = _mm512_xor_si512(rng, _mm512_and_si512(_mm512_srli_epi64(rng, 29), mask1));
+      rng = _mm512_xor_si512(rng, _mm512_and_si512(_mm512_slli_epi64(rng, 17), mask2));
+      rng = _mm512_xor_si512(rng, _mm512_and_si512(_mm512_slli_epi64(rng, 37), mask3));
+      rng = _mm512_xor_si512(rng, _mm512_srli_epi64(rng, 43));
+      _mm512_storeu_si512((void*) (randnums+i), rng);
+   }
+   temper_mtstate_avx2(mtstate+i, randnums+i, n-i);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX-512 version of uniform_mtstate_scalar
+// Variables:
+//    mtstate: first element of the state to convert
+//    randnums: array to hold the random numbers
+//    n: number of elements to convert
+//    onebits: exponent bits of 1.0, optionally with the lowest mantissa bit
+//    scale: factor of x
+//    offset: summand of x*scale
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx512f")))
+static void uniform_mtstate_avx512(const long int* mtstate, double* randnums, size_t n,
+                                   unsigned long int onebits, double scale, double offset){
+   const __m512i mask1 = _mm512_set1_epi64((long long) 0x5555555555555555);
+   const __m512i mask2 = _mm512_set1_epi64((long long) 0x71d67fffeda60000);
+   const __m512i mask3 = _mm512_set1_epi64((long long) 0xfff7eee000000000);
+   const __m512i one = _mm512_set1_epi64((long long) onebits);
+   const __m512d vscale = _mm512_set1_pd(scale);
+   const __m512d voffset = _mm512_set1_pd(offset);
+
+   size_t i = 0;
+   for (; i+8<=n; i+=8){
+      __m512i rng = _mm512_loadu_si512((const void*) (mtstate+i));
+      rng = _mm512_xor_si512(rng, _mm512_and_si512(_mm512_srli_epi64(rng, 29), mask1));
+      rng = _mm512_xor_si512(rng, _mm512_and_si512(_mm512_slli_epi64(rng, 17), mask2));
+      rng = _mm512_xor_si512(rng, _mm512_and_si512(_mm512_slli_epi64(rng, 37), mask3));
+      rng = _mm512_xor_si512(rng, _mm512_srli_epi64(rng, 43));
+      __m512d x = _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(rng, 12), one));
+      _mm512_storeu_pd(randnums+i, _mm512_add_pd(_mm512_mul_pd(x, vscale), voffset));
+   }
+   uniform_mtstate_avx2(mtstate+i, randnums+i, n-i, onebits, scale, offset);
+}
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    AVX2 version of box_muller_pairs_scalar, four pairs at a time
+// Variables:
+//    uniforms: npairs pairs (u1, u2) with u1 in (0,1] and u2 in [0,1]
+//    gaussians: array to hold npairs pairs (z1, z2)
+//    npairs: number of pairs
+/////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static void box_muller_pairs_avx2(const double* uniforms, double* gaussians, size_t npairs){
+   const __m256d one = _mm256_set1_pd(1.0);
+   const __m256d two = _mm256_set1_pd(2.0);
+   const __m256d half = _mm256_set1_pd(0.5);
+   const __m256i low32 = _mm256_set1_epi64x(0xffffffff);
+   const __m256i low20 = _mm256_set1_epi64x(0x000fffff);
+   const __m256i one64 = _mm256_set1_epi64x(1);
+   const __m256i two64 = _mm256_set1_epi64x(2);
+
+   size_t i = 0;
+   for (; i+4<=npairs; i+=4){
+      // lanes hold the pairs 0, 2, 1, 3 which is undone when storing
+      __m256d a = _mm256_loadu_pd(uniforms+2*i);
+      __m256d b = _mm256_loadu_pd(uniforms+2*i+4);
+      __m256d u1 = _mm256_unpacklo_pd(a, b);
+      __m256d u2 = _mm256_unpackhi_pd(a, b);
+
+      // log(u1)
+      __m256i bits = _mm256_castpd_si256(u1);
+      __m256i high = _mm256_add_epi64(_mm256_srli_epi64(bits, 32),
+                                      _mm256_set1_epi64x(LOGHIGHSHIFT));
+      __m256d dk = _mm256_sub_pd(
+         _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(high, 20),
+                                             _mm256_set1_epi64x(LOGEXPBIAS))),
+         _mm256_set1_pd(LOGEXPOFFSET));
+      high = _mm256_add_epi64(_mm256_and_si256(high, low20),
+                              _mm256_set1_epi64x(LOGHIGHSQRTHALF));
+      __m256d f = _mm256_sub_pd(
+         _mm256_castsi256_pd(_mm256_or_si256(_mm256_slli_epi64(high, 32),
+                                             _mm256_and_si256(bits, low32))),
+         one);
+      __m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(half, f), f);
+      __m256d s = _mm256_div_pd(f, _mm256_add_pd(two, f));
+      __m256d z = _mm256_mul_pd(s, s);
+      __m256d w = _mm256_mul_pd(z, z);
+      __m256d t1 = _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(LG2),
+                   _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(LG4),
+                   _mm256_mul_pd(w, _mm256_set1_pd(LG6))))));
+      __m256d t2 = _mm256_mul_pd(z, _mm256_add_pd(_mm256_set1_pd(LG1),
+                   _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(LG3),
+                   _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(LG5),
+                   _mm256_mul_pd(w, _mm256_set1_pd(LG7))))))));
+      __m256d logu1 = _mm256_mul_pd(s, _mm256_add_pd(hfsq, _mm256_add_pd(t2, t1)));
+      logu1 = _mm256_add_pd(logu1, _mm256_mul_pd(dk, _mm256_set1_pd(LN2LO)));
+      logu1 = _mm256_sub_pd(logu1, hfsq);
+      logu1 = _mm256_add_pd(logu1, f);
+      logu1 = _mm256_add_pd(logu1, _mm256_mul_pd(dk, _mm256_set1_pd(LN2HI)));
+
+      __m256d radius = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0), logu1));
+
+      // 2 pi u2 = 2 pi (u2-q/4) + q pi/2 with an exact reduction
+      __m256d rounded = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(4.0), u2),
+                                      _mm256_set1_pd(ROUNDMAGIC));
+      __m256i quadrant = _mm256_castpd_si256(rounded);
+      __m256d x = _mm256_mul_pd(_mm256_set1_pd(TWOPI),
+         _mm256_sub_pd(u2, _mm256_mul_pd(_mm256_set1_pd(0.25),
+                       _mm256_sub_pd(rounded, _mm256_set1_pd(ROUNDMAGIC)))));
+      z = _mm256_mul_pd(x, x);
+      w = _mm256_mul_pd(z, z);
+      __m256d r = _mm256_add_pd(_mm256_add_pd(_mm256_set1_pd(SIN2),
+                     _mm256_mul_pd(z, _mm256_add_pd(_mm256_set1_pd(SIN3),
+                     _mm256_mul_pd(z, _mm256_set1_pd(SIN4))))),
+                  _mm256_mul_pd(_mm256_mul_pd(z, w), _mm256_add_pd(_mm256_set1_pd(SIN5),
+                     _mm256_mul_pd(z, _mm256_set1_pd(SIN6)))));
+      __m256d sinx = _mm256_add_pd(x, _mm256_mul_pd(_mm256_mul_pd(z, x),
+                        _mm256_add_pd(_mm256_set1_pd(SIN1), _mm256_mul_pd(z, r))));
+      r = _mm256_add_pd(
+             _mm256_mul_pd(z, _mm256_add_pd(_mm256_set1_pd(COS1),
+                _mm256_mul_pd(z, _mm256_add_pd(_mm256_set1_pd(COS2),
+                _mm256_mul_pd(z, _mm256_set1_pd(COS3)))))),
+             _mm256_mul_pd(_mm256_mul_pd(w, w), _mm256_add_pd(_mm256_set1_pd(COS4),
+                _mm256_mul_pd(z, _mm256_add_pd(_mm256_set1_pd(COS5),
+                _mm256_mul_pd(z, _mm256_set1_pd(COS6)))))));
+      __m256d hz = _mm256_mul_pd(half, z);
+      w = _mm256_sub_pd(one, hz);
+      __m256d cosx = _mm256_add_pd(w, _mm256_add_pd(
+         _mm256_sub_pd(_mm256_sub_pd(one, w), hz), _mm256_mul_pd(z, r)));
+
+      __m256d odd = _mm256_castsi256_pd(_mm256_cmpeq_epi64(
+         _mm256_and_si256(quadrant, one64), one64));
+      __m256d c = _mm256_blendv_pd(cosx, sinx, odd);
+      __m256d sn = _mm256_blendv_pd(sinx, cosx, odd);
+      c = _mm256_xor_pd(c, _mm256_castsi256_pd(_mm256_slli_epi64(
+         _mm256_and_si256(_mm256_add_epi64(quadrant, one64), two64), 62)));
+      sn = _mm256_xor_pd(sn, _mm256_castsi256_pd(_mm256_slli_epi64(
+         _mm256_and_si256(quadrant, two64), 62)));
+
+      __m256d z1 = _mm256_mul_pd(radius, c);
+      __m256d z2 = _mm256_mul_pd(radius, sn);
+      _mm256_storeu_pd(gaussians+2*i, _mm256_unpacklo_pd(z1, z2));
+      _mm256_storeu_pd(gaussians+2*i+4, _mm256_unpackhi_pd(z1, z2));
+   }
+   box_muller_pairs_scalar(uniforms+2*i, gaussians+2*i, npairs-i);
+}
+#endif
+
+static void regenerate_mtstate_select(long int* mtstate);
+static void regenerate_mtstate_lanes_select(long int* mtstate, int nlanes);
+static void temper_mtstate_select(const long int* mtstate, long int* randnums, size_t n);
+static void box_muller_pairs_select(const double* uniforms, double* gaussians, size_t npairs);
+static void uniform_mtstate_select(const long int* mtstate, double* randnums, size_t n,
+                                   unsigned long int onebits, double scale, double offset);
+
+static void (*regenerate_mtstate_kernel)(long int*) = regenerate_mtstate_select;
+static void (*regenerate_mtstate_lanes_kernel)(long int*, int) = regenerate_mtstate_lanes_select;
+static void (*temper_mtstate_kernel)(const long int*, long int*, size_t) = temper_mtstate_select;
+static void (*box_muller_pairs_kernel)(const double*, double*, size_t) = box_muller_pairs_select;
+static void (*uniform_mtstate_kernel)(const long int*, double*, size_t, unsigned long int,
+                                      double, double) = uniform_mtstate_select;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Checks the cpu features and selects the kernels to use.
+//    Every thread selects the same kernels, so concurrent first calls
+//    only store identical values. The pointers are stored and loaded
+//    atomically, relaxed as they point to code and publish no data.
+/////////////////////////////////////////////////////////////////////////////
+static void select_kernels(void){
+   void (*regenerate)(long int*) = regenerate_mtstate_scalar;
+   void (*regenerate_lanes)(long int*, int) = regenerate_mtstate_lanes_scalar;
+   void (*temper)(const long int*, long int*, size_t) = temper_mtstate_scalar;
+   void (*box_muller)(const double*, double*, size_t) = box_muller_pairs_scalar;
+   void (*uniform)(const long int*, double*, size_t, unsigned long int, double, double) =
+      uniform_mtstate_scalar;
+
+#ifdef MT_RANDOM_X86_KERNELS
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx512f")){
+      regenerate = regenerate_mtstate_avx512;
+      regenerate_lanes = regenerate_mtstate_lanes_avx512;
+      temper = temper_mtstate_avx512;
+      uniform = uniform_mtstate_avx512;
+   } else if (__builtin_cpu_supports("avx2")){
+      regenerate = regenerate_mtstate_avx2;
+      regenerate_lanes = regenerate_mtstate_lanes_avx2;
+      temper = temper_mtstate_avx2;
+      uniform = uniform_mtstate_avx2;
+   }
+   if (__builtin_cpu_supports("avx2")){
+      box_muller = box_muller_pairs_avx2;
+   }
+#endif
+
+   __atomic_store_n(&regenerate_mtstate_kernel, regenerate, __ATOMIC_RELAXED);
+   __atomic_store_n(&regenerate_mtstate_lanes_kernel, regenerate_lanes, __ATOMIC_RELAXED);
+   __atomic_store_n(&temper_mtstate_kernel, temper, __ATOMIC_RELAXED);
+   __atomic_store_n(&box_muller_pairs_kernel, box_muller, __ATOMIC_RELAXED);
+   __atomic_store_n(&uniform_mtstate_kernel, uniform, __ATOMIC_RELAXED);
+}
+
+static void regenerate_mtstate_select(long int* mtstate){
+   select_kernels();
+   __atomic_load_n(&regenerate_mtstate_kernel, __ATOMIC_RELAXED)(mtstate);
+}
+
+static void regenerate_mtstate_lanes_select(long int* mtstate, int nlanes){
+   select_kernels();
+   __atomic_load_n(&regenerate_mtstate_lanes_kernel, __ATOMIC_RELAXED)(mtstate, nlanes);
+}
+
+static void temper_mtstate_select(const long int* mtstate, long int* randnums, size_t n){
+   select_kernels();
+   __atomic_load_n(&temper_mtstate_kernel, __ATOMIC_RELAXED)(mtstate, randnums, n);
+}
+
+static void box_muller_pairs_select(const double* uniforms, double* gaussians, size_t npairs){
+   select_kernels();
+   __atomic_load_n(&box_muller_pairs_kernel, __ATOMIC_RELAXED)(uniforms, gaussians, npairs);
+}
+
+static void uniform_mtstate_select(const long int* mtstate, double* randnums, size_t n,
+                                   unsigned long int onebits, double scale, double offset){
+   select_kernels();
+   __atomic_load_n(&uniform_mtstate_kernel, __ATOMIC_RELAXED)(mtstate, randnums, n,
+                                                              onebits, scale, offset);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in a mersenne twister state.
+//    Uses the fastest kernel the cpu supports.
+// Variables:
+//    mtstate: State of the mersenne twister
+/////////////////////////////////////////////////////////////////////////////
+void regenerate_mtstate(long int* mtstate){
+   __atomic_load_n(&regenerate_mtstate_kernel, __ATOMIC_RELAXED)(mtstate);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Creates a new set of random numbers in nlanes interleaved mersenne
+//    twister states. Uses the fastest kernel the cpu supports.
+// Variables:
+//    mtstate: interleaved states, element i of lane l at i*nlanes+l
+//    nlanes: number of interleaved states
+/////////////////////////////////////////////////////////////////////////////
+void regenerate_mtstate_lanes(long int* mtstate, int nlanes){
+   __atomic_load_n(&regenerate_mtstate_lanes_kernel, __ATOMIC_RELAXED)(mtstate, nlanes);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Tempers a consecutive part of a mersenne twister state.
+//    Uses the fastest kernel the cpu supports.
+// Variables:
+//    mtstate: first element of the state to temper
+//    randnums: array to hold the random numbers
+//    n: number of elements to temper
+/////////////////////////////////////////////////////////////////////////////
+void temper_mtstate(const long int* mtstate, long int* randnums, size_t n){
+   __atomic_load_n(&temper_mtstate_kernel, __ATOMIC_RELAXED)(mtstate, randnums, n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Performs the Box-Muller transform on pairs of uniform random numbers
+//    with polynomial approximations of log, sin and cos.
+//    Uses the fastest kernel the cpu supports, all kernels give identical
+//    results. Pairs with u1 == 0 give meaningless results.
+// Variables:
+//    uniforms: npairs pairs (u1, u2) with u1 in (0,1] and u2 in [0,1]
+//    gaussians: array to hold npairs pairs (z1, z2)
+//    npairs: number of pairs
+/////////////////////////////////////////////////////////////////////////////
+void box_muller_pairs(const double* uniforms, double* gaussians, size_t npairs){
+   __atomic_load_n(&box_muller_pairs_kernel, __ATOMIC_RELAXED)(uniforms, gaussians, npairs);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Tempers a consecutive part of a mersenne twister state and converts
+//    it to doubles x*scale+offset with x in [1,2) from the exponent bits.
+//    Uses the fastest kernel the cpu supports, all kernels give identical
+//    results.
+// Variables:
+//    mtstate: first element of the state to convert
+//    randnums: array to hold the random numbers
+//    n: number of elements to convert
+//    onebits: exponent bits of 1.0, optionally with the lowest mantissa bit
+//    scale: factor of x
+//    offset: summand of x*scale
+/////////////////////////////////////////////////////////////////////////////
+void uniform_mtstate(const long int* mtstate, double* randnums, size_t n,
+                     unsigned long int onebits, double scale, double offset){
+   __atomic_load_n(&uniform_mtstate_kernel, __ATOMIC_RELAXED)(mtstate, randnums, n,
+                                                              onebits, scale, offset);
+}
@@ -0,0 +1,641 @@
+#include <stdlib.h>
+#include <math.h>
+#include "MT_random.h"
+#include "MT_random_internal.h"
+#include "MT_random_ziggurat.h"
+
+#define ZIGLAYERS 256
+#define ZIGBUFFERLENGTH 256
+
+#define MANTISSAMASK 0x000FFFFFFFFFFFFF
+#define INV2POW53 (1.0/9007199254740992.0)
+
+// start of the tail of the lowest layer
+static const double zig_norm_r = 3.6541528853610088 ;
+static const double zig_exp_r = 7.6971174701310497 ;
+
+/////////////////////////////////////////////////////////////////////////////
+// Ziggurat tables for exp(-x^2/2) with 256 layers of equal area.
+// Layer i covers x < x_i with x_0 = v/f(r), x_1 = r and x_256 = 0.
+//    zig_norm_k: 2^52 x_(i+1)/x_i, below the number lies inside the curve
+//    zig_norm_w: x_i/2^52, scales a 52 bit integer to the layer width
+//    zig_norm_f: exp(-x_i^2/2)
+/////////////////////////////////////////////////////////////////////////////
+static const unsigned long int zig_norm_k[ZIGLAYERS] = {
+   0x0ef33d8025ef64ul, 0x0f1a5a4b331c4aul, 0x0f66c5f7f0302cul, 0x0f89fa48a41dfbul,
+   0x0f9e971e014597ul, 0x0fac40582a2873ul, 0x0fb606c4005434ul, 0x0fbd6581c0b83aul,
+   0x0fc32b2f1e22edul, 0x0fc7d26ecd2d23ul, 0x0fcba8d85e11b1ul, 0x0fcee204761f9eul,
+   0x0fd1a1a7b4c7acul, 0x0fd40149e2f011ul, 0x0fd613adbd650bul, 0x0fd7e6ef48cf03ul,
+   0x0fd985e1b2ba75ul, 0x0fdaf8f82e0282ul, 0x0fdc46e529bf13ul, 0x0fdd7509c63bfdul,
+   0x0fde87c57efeaaul, 0x0fdf82b02b71a9ul, 0x0fe068c4ee67aful, 0x0fe13c82788314ul,
+   0x0fe20003995557ul, 0x0fe2b5122fe4fdul, 0x0fe35d35eeb19bul, 0x0fe3f9bffd1e37ul,
+   0x0fe48bd436f458ul, 0x0fe51470977280ul, 0x0fe5947338f742ul, 0x0fe60c9f38307eul,
+   0x0fe67da0b6abd8ul, 0x0fe6e8102aa202ul, 0x0fe74c751f6aa6ul, 0x0fe7ab488233bful,
+   0x0fe804f690a940ul, 0x0fe859e07ab1eaul, 0x0fe8aa5dc4e8e6ul, 0x0fe8f6bd76c5d6ul,
+   0x0fe93f471d4729ul, 0x0fe9843ba947a3ul, 0x0fe9c5d62f563aul, 0x0fea044c8dd9f6ul,
+   0x0fea3fcffd73e5ul, 0x0fea788d8ee326ul, 0x0feaaeae992257ul, 0x0feae2591a02e9ul,
+   0x0feb13b00b2d4bul, 0x0feb42d3ad1f9eul, 0x0feb6fe1c98542ul, 0x0feb9af5ee0cdcul,
+   0x0febc429a0b691ul, 0x0febeb948e6fd0ul, 0x0fec114cb4b334ul, 0x0fec356686c961ul,
+   0x0fec57f50f31fdul, 0x0fec790a0da978ul, 0x0fec98b61230c1ul, 0x0fecb708956eb4ul,
+   0x0fecd4100eb7b8ul, 0x0fecefda07fe34ul, 0x0fed0a732fe643ul, 0x0fed23e76a2fd7ul,
+   0x0fed3c41dea422ul, 0x0fed538d06adfful, 0x0fed69d2b9c02bul, 0x0fed7f1c38a836ul,
+   0x0fed937237e98dul, 0x0feda6dce938c9ul, 0x0fedb964042cf4ul, 0x0fedcb0ece39d3ul,
+   0x0feddbe422047dul, 0x0fedebea76216cul, 0x0fedfb27e349cbul, 0x0fee09a22a1447ul,
+   0x0fee175eb83c59ul, 0x0fee2462ad8204ul, 0x0fee30b2e02ad7ul, 0x0fee3c53e12c4ful,
+   0x0fee474a0006cful, 0x0fee51994e57b6ul, 0x0fee5b45a32889ul, 0x0fee64529e007ful,
+   0x0fee6cc3a9bd5eul, 0x0fee749bff37fful, 0x0fee7bdea7b888ul, 0x0fee828e7f3dfdul,
+   0x0fee88ae369c79ul, 0x0fee8e40557515ul, 0x0fee93473c0a39ul, 0x0fee97c524f2e3ul,
+   0x0fee9bbc26af2eul, 0x0fee9f2e352025ul, 0x0feea21d22e4daul, 0x0feea48aa29e83ul,
+   0x0feea678481d24ul, 0x0feea7e7897654ul, 0x0feea8d9c0075eul, 0x0feea95029640ful,
+   0x0feea94be8333cul, 0x0feea8ce04fa0aul, 0x0feea7d76ed6f9ul, 0x0feea668fc2d70ul,
+   0x0feea4836b42abul, 0x0feea22762ccaeul, 0x0fee9f557273f4ul, 0x0fee9c0e13485bul,
+   0x0fee9851a829ebul, 0x0fee94207e25daul, 0x0fee8f7accc851ul, 0x0fee8a60b66343ul,
+   0x0fee84d2484ab2ul, 0x0fee7ecf7b06b9ul, 0x0fee7858327b81ul, 0x0fee716c3e077aul,
+   0x0fee6a0b5897f1ul, 0x0fee623528b42dul, 0x0fee59e9407f41ul, 0x0fee51271db086ul,
+   0x0fee47ee2982f3ul, 0x0fee3e3db89b3cul, 0x0fee34150ae4bbul, 0x0fee29734b6524ul,
+   0x0fee1e579006e0ul, 0x0fee12c0d95a06ul, 0x0fee06ae124bc4ul, 0x0fedfa1e0fd414ul,
+   0x0feded0f90997ful, 0x0feddf813c8ad3ul, 0x0fedd171a46e52ul, 0x0fedc2df416652ul,
+   0x0fedb3c8746ab3ul, 0x0feda42b85b704ul, 0x0fed9406a42cc8ul, 0x0fed8357e4a982ul,
+   0x0fed721d414fe8ul, 0x0fed605498c3ddul, 0x0fed4dfbad586eul, 0x0fed3b10242f4cul,
+   0x0fed278f844903ul, 0x0fed1377358528ul, 0x0fecfec47f91b7ul, 0x0fece97488c8b3ul,
+   0x0fecd38454fb15ul, 0x0fecbcf0c427feul, 0x0feca5b6911f10ul, 0x0fec8dd2500cb4ul,
+   0x0fec75406ceef4ul, 0x0fec5bfd29f196ul, 0x0fec42049dafd3ul, 0x0fec2752b15a14ul,
+   0x0fec0be31ebde8ul, 0x0febefb16e2e3dul, 0x0febd2b8f449cful, 0x0febb4f4cf9d7cul,
+   0x0feb965fe62013ul, 0x0feb76f4e284f9ul, 0x0feb56ae3162b4ul, 0x0feb3585fe2a4bul,
+   0x0feb13762fec12ul, 0x0feaf07865e63cul, 0x0feacc85f3d91ful, 0x0feaa797de1ceful,
+   0x0fea81a6d57419ul, 0x0fea5aab32952dul, 0x0fea329cf166a4ul, 0x0fea0973abe67bul,
+   0x0fe9df2694b6d5ul, 0x0fe9b3ac714865ul, 0x0fe986fb939aa1ul, 0x0fe95909d388ebul,
+   0x0fe929cc879b1dul, 0x0fe8f9387d4ef6ul, 0x0fe8c741f0cebcul, 0x0fe893dc840864ul,
+   0x0fe85efb35173aul, 0x0fe8289053f08cul, 0x0fe7f08d774243ul, 0x0fe7b6e37070a1ul,
+   0x0fe77b823e9e39ul, 0x0fe73e5900a702ul, 0x0fe6ff55e5f4f2ul, 0x0fe6be661e11aaul,
+   0x0fe67b75c6d578ul, 0x0fe6366fd91078ul, 0x0fe5ef3e138689ul, 0x0fe5a5c8e41211ul,
+   0x0fe559f74ebc76ul, 0x0fe50baed29524ul, 0x0fe4bad34c095bul, 0x0fe46746d47734ul,
+   0x0fe410e99ead7eul, 0x0fe3b799d0002aul, 0x0fe35b33558d4aul, 0x0fe2fb8fb54186ul,
+   0x0fe29885da1b92ul, 0x0fe231e9db1ca9ul, 0x0fe1c78cbc3f99ul, 0x0fe1593c28b84cul,
+   0x0fe0e6c225a259ul, 0x0fe06fe4bc24f2ul, 0x0fdff46599ed3ful, 0x0fdf7401a6b42eul,
+   0x0fdeee708d514ful, 0x0fde6364369f63ul, 0x0fddd288342f90ul, 0x0fdd3b8118729dul,
+   0x0fdc9debb99a7dul, 0x0fdbf95c5bfcd1ul, 0x0fdb4d5dc02e1ful, 0x0fda9970105e8bul,
+   0x0fd9dd07a7add2ul, 0x0fd9178bad2c8bul, 0x0fd848547b08e8ul, 0x0fd76ea9c8e831ul,
+   0x0fd689c08e99ecul, 0x0fd598b8920f53ul, 0x0fd49a9990b479ul, 0x0fd38e4ff0c91eul,
+   0x0fd272a8e2f450ul, 0x0fd1464dd6c4e5ul, 0x0fd007bf1dc930ul, 0x0fceb54d8fec99ul,
+   0x0fcd4d12f839c4ul, 0x0fcbcce902231aul, 0x0fca325e4bde85ul, 0x0fc87aa92896a4ul,
+   0x0fc6a2977aee2ful, 0x0fc4a67ae25bd1ul, 0x0fc2821037a248ul, 0x0fc03060ff6c57ul,
+   0x0fbdab9d040beeul, 0x0fbaece9a1e50cul, 0x0fb7ec2366fe77ul, 0x0fb49f8d5374c5ul,
+   0x0fb0fb6718b90eul, 0x0facf160d354dbul, 0x0fa86fde5b4bf7ul, 0x0fa360f581fa71ul,
+   0x0f9da907dbf507ul, 0x0f9724c74dd0daul, 0x0f8fa6578325ddul, 0x0f86f10c6357d1ul,
+   0x0f7cb2ec284499ul, 0x0f707a755396a3ul, 0x0f61a5e41ba395ul, 0x0f4f4695612558ul,
+   0x0f37ed61ffcb13ul, 0x0f19470afa44a7ul, 0x0eef4b817ecab3ul, 0x0eb255e9d3f776ul,
+   0x0e51f67ec1eeddul, 0x0da354fabd8128ul, 0x0c08be98fbc661ul, 0x00000000000000ul
+};
+
+static const double zig_norm_w[ZIGLAYERS] = {
+   8.68362706080131701e-16, 8.11384933765648419e-16, 7.65893637080557177e-16, 7.37242430179879694e-16,
+   7.15999493483066224e-16, 6.98971833638761798e-16, 6.84680341756425679e-16, 6.72315046250558466e-16,
+   6.61382788509766218e-16, 6.51560331734499160e-16, 6.42623965954805442e-16, 6.34412240712750401e-16,
+   6.26804696330128242e-16, 6.19708989458162457e-16, 6.13052720872527962e-16, 6.06778040933344753e-16,
+   6.00837969627190734e-16, 5.95193814964144317e-16, 5.89813317647789844e-16, 5.84669289345547802e-16,
+   5.79738594572459266e-16, 5.75001376891989425e-16, 5.70440462129138711e-16, 5.66040892008242020e-16,
+   5.61789555355541370e-16, 5.57674893292657352e-16, 5.53686661246787305e-16, 5.49815735089281115e-16,
+   5.46053951907477745e-16, 5.42393978220170938e-16, 5.38829200133405024e-16, 5.35353631181649392e-16,
+   5.31961834533839742e-16, 5.28648856950494216e-16, 5.25410172417759535e-16, 5.22241633800023330e-16,
+   5.19139431175769761e-16, 5.16100055774322726e-16, 5.13120268630678275e-16, 5.10197073234156086e-16,
+   5.07327691573354108e-16, 5.04509543081872749e-16, 5.01740226071808946e-16, 4.99017501309182147e-16,
+   4.96339277440398627e-16, 4.93703598024033356e-16, 4.91108629959526857e-16, 4.88552653135360245e-16,
+   4.86034051145081097e-16, 4.83551302941152417e-16, 4.81102975314741622e-16, 4.78687716104872186e-16,
+   4.76304248053313639e-16, 4.73951363232586617e-16, 4.71627917983835031e-16, 4.69332828309332693e-16,
+   4.67065065671262862e-16, 4.64823653154320442e-16, 4.62607661954784272e-16, 4.60416208163114986e-16,
+   4.58248449810956371e-16, 4.56103584156741911e-16, 4.53980845187003105e-16, 4.51879501313005580e-16,
+   4.49798853244554672e-16, 4.47738232024753091e-16, 4.45696997211204011e-16, 4.43674535190656431e-16,
+   4.41670257615420053e-16, 4.39683599951051842e-16, 4.37714020125858451e-16, 4.35760997273684605e-16,
+   4.33824030562278785e-16, 4.31902638100262599e-16, 4.29996355916382885e-16, 4.28104737005311272e-16,
+   4.26227350434779415e-16, 4.24363780509307352e-16, 4.22513625986204444e-16, 4.20676499339901018e-16,
+   4.18852026071010687e-16, 4.17039844056831045e-16, 4.15239602940268292e-16, 4.13450963554423107e-16,
+   4.11673597380302126e-16, 4.09907186035326249e-16, 4.08151420790493479e-16, 4.06406002114224694e-16,
+   4.04670639241074699e-16, 4.02945049763632497e-16, 4.01228959246062612e-16, 3.99522100857856157e-16,
+   3.97824215026467914e-16, 3.96135049107613198e-16, 3.94454357072087416e-16, 3.92781899208053907e-16,
+   3.91117441837820296e-16, 3.89460757048192374e-16, 3.87811622433558475e-16, 3.86169820850914730e-16,
+   3.84535140186095759e-16, 3.82907373130524170e-16, 3.81286316967837640e-16, 3.79671773369794327e-16,
+   3.78063548200895890e-16, 3.76461451331202721e-16, 3.74865296456848721e-16, 3.73274900927794254e-16,
+   3.71690085582382199e-16, 3.70110674588289786e-16, 3.68536495289491352e-16, 3.66967378058870090e-16,
+   3.65403156156136996e-16, 3.63843665590734439e-16, 3.62288744989419152e-16, 3.60738235468235138e-16,
+   3.59191980508602995e-16, 3.57649825837265051e-16, 3.56111619309838843e-16, 3.54577210797743572e-16,
+   3.53046452078274009e-16, 3.51519196727607441e-16, 3.49995300016538100e-16, 3.48474618808741371e-16,
+   3.46957011461378353e-16, 3.45442337727858402e-16, 3.43930458662583134e-16, 3.42421236527501816e-16,
+   3.40914534700312604e-16, 3.39410217584148914e-16, 3.37908150518594980e-16, 3.36408199691876508e-16,
+   3.34910232054077845e-16, 3.33414115231237246e-16, 3.31919717440175234e-16, 3.30426907403912839e-16,
+   3.28935554267536968e-16, 3.27445527514370672e-16, 3.25956696882307838e-16, 3.24468932280169778e-16,
+   3.22982103703941558e-16, 3.21496081152744705e-16, 3.20010734544401138e-16, 3.18525933630440649e-16,
+   3.17041547910402853e-16, 3.15557446545280064e-16, 3.14073498269944617e-16, 3.12589571304399843e-16,
+   3.11105533263689248e-16, 3.09621251066292204e-16, 3.08136590840829668e-16, 3.06651417830895402e-16,
+   3.05165596297821824e-16, 3.03678989421180086e-16, 3.02191459196806053e-16, 3.00702866332132955e-16,
+   2.99213070138601159e-16, 2.97721928420902743e-16, 2.96229297362806451e-16, 2.94735031409293292e-16,
+   2.93238983144718016e-16, 2.91741003166694356e-16, 2.90240939955384036e-16, 2.88738639737847995e-16,
+   2.87233946347097797e-16, 2.85726701075459952e-16, 2.84216742521840459e-16, 2.82703906432447775e-16,
+   2.81188025534501926e-16, 2.79668929362422857e-16, 2.78146444075954262e-16, 2.76620392269638884e-16,
+   2.75090592773016566e-16, 2.73556860440867810e-16, 2.72019005932773108e-16, 2.70476835481199420e-16,
+   2.68930150647261493e-16, 2.67378748063236231e-16, 2.65822419160830582e-16, 2.64260949884118853e-16,
+   2.62694120385972417e-16, 2.61121704706701791e-16, 2.59543470433516922e-16, 2.57959178339286625e-16,
+   2.56368581998939585e-16, 2.54771427381694368e-16, 2.53167452417135778e-16, 2.51556386532965737e-16,
+   2.49937950162045193e-16, 2.48311854216108620e-16, 2.46677799523270350e-16, 2.45035476226149343e-16,
+   2.43384563137110089e-16, 2.41724727046750006e-16, 2.40055621981350381e-16, 2.38376888404542188e-16,
+   2.36688152357915791e-16, 2.34989024534709354e-16, 2.33279099280043364e-16, 2.31557953510407840e-16,
+   2.29825145544246691e-16, 2.28080213834501608e-16, 2.26322675592856688e-16, 2.24552025294143454e-16,
+   2.22767733047895436e-16, 2.20969242822353102e-16, 2.19155970504272610e-16, 2.17327301775643576e-16,
+   2.15482589785814482e-16, 2.13621152594498582e-16, 2.11742270357603345e-16, 2.09845182223703418e-16,
+   2.07929082904140074e-16, 2.05993118874036965e-16, 2.04036384154801995e-16, 2.02057915620716416e-16,
+   2.00056687762733177e-16, 1.98031606831281616e-16, 1.95981504266288145e-16, 1.93905129306250963e-16,
+   1.91801140648386124e-16, 1.89668097007747522e-16, 1.87504446393738743e-16, 1.85308513886180091e-16,
+   1.83078487648267428e-16, 1.80812402857991424e-16, 1.78508123169767199e-16, 1.76163319230009886e-16,
+   1.73775443658648495e-16, 1.71341701765596459e-16, 1.68859017086765841e-16, 1.66323990584208230e-16,
+   1.63732852039698433e-16, 1.61081401752749205e-16, 1.58364940092908755e-16, 1.55578181694607541e-16,
+   1.52715150035961856e-16, 1.49769046683910220e-16, 1.46732087423644022e-16, 1.43595294520569233e-16,
+   1.40348230012423574e-16, 1.36978648425711737e-16, 1.33472037368240932e-16, 1.29810998862640020e-16,
+   1.25974399146370607e-16, 1.21936172787143313e-16, 1.17663594570228891e-16, 1.13114701961089987e-16,
+   1.08234302884476445e-16, 1.02947503142409724e-16, 9.71486007656771254e-17, 9.06806040505942312e-17,
+   8.32936681579302947e-17, 7.45487048124761000e-17, 6.35435241740514521e-17, 4.77933017572754885e-17
+};
+
+static const double zig_norm_f[ZIGLAYERS+1] = {
+   4.77467764609386196e-04, 1.26028593049859797e-03, 2.60907274610216403e-03, 4.03797259336303744e-03,
+   5.52240329925101064e-03, 7.05087547137324151e-03, 8.61658276939874894e-03, 1.02149714397014868e-02,
+   1.18427578579079103e-02, 1.34974506017398899e-02, 1.51770883079353370e-02, 1.68800831525431870e-02,
+   1.86051212757246710e-02, 2.03510962300445380e-02, 2.21170627073088988e-02, 2.39022033057959098e-02,
+   2.57058040085489450e-02, 2.75272356696031478e-02, 2.93659397581333866e-02, 3.12214171919203282e-02,
+   3.30932194585786196e-02, 3.49809414617161737e-02, 3.68842156885674025e-02, 3.88027074045262377e-02,
+   4.07361106559410852e-02, 4.26841449164746117e-02, 4.46465522512946023e-02, 4.66230949019305271e-02,
+   4.86135532158686948e-02, 5.06177238609479413e-02, 5.26354182767923770e-02, 5.46664613248890943e-02,
+   5.67106901062030822e-02, 5.87679529209339246e-02, 6.08381083495400168e-02, 6.29210244377582245e-02,
+   6.50165779712429531e-02, 6.71246538277885663e-02, 6.92451443970068248e-02, 7.13779490588904719e-02,
+   7.35229737139813794e-02, 7.56801303589271779e-02, 7.78493367020961224e-02, 8.00305158146631529e-02,
+   8.22235958132029876e-02, 8.44285095703535410e-02, 8.66451944505581412e-02, 8.88735920682759695e-02,
+   9.11136480663738285e-02, 9.33653119126910958e-02, 9.56285367130090824e-02, 9.79032790388625895e-02,
+   1.00189498768810101e-01, 1.02487158941935344e-01, 1.04796225622487207e-01, 1.07116667774683996e-01,
+   1.09448457146812048e-01, 1.11791568163838437e-01, 1.14145977827838779e-01, 1.16511665625611230e-01,
+   1.18888613442910379e-01, 1.21276805484790626e-01, 1.23676228201596905e-01, 1.26086870220186276e-01,
+   1.28508722279999904e-01, 1.30941777173644719e-01, 1.33386029691669517e-01, 1.35841476571254116e-01,
+   1.38308116448551094e-01, 1.40785949814445061e-01, 1.43274978973513822e-01, 1.45775208005994417e-01,
+   1.48286642732574941e-01, 1.50809290681846148e-01, 1.53343161060263300e-01, 1.55888264724479753e-01,
+   1.58444614155924840e-01, 1.61012223437511648e-01, 1.63591108232366278e-01, 1.66181285764482628e-01,
+   1.68782774801212093e-01, 1.71395595637506504e-01, 1.74019770081839359e-01, 1.76655321443735552e-01,
+   1.79302274522848221e-01, 1.81960655599523125e-01, 1.84630492426799853e-01, 1.87311814223800804e-01,
+   1.90004651670465458e-01, 1.92709036903589648e-01, 1.95425003514134804e-01, 1.98152586545775666e-01,
+   2.00891822494657174e-01, 2.03642749310335436e-01, 2.06405406397881241e-01, 2.09179834621125493e-01,
+   2.11966076307030599e-01, 2.14764175251174000e-01, 2.17574176724331519e-01, 2.20396127480152332e-01,
+   2.23230075763917818e-01, 2.26076071322380528e-01, 2.28934165414680535e-01, 2.31804410824338891e-01,
+   2.34686861872330260e-01, 2.37581574431238340e-01, 2.40488605940500838e-01, 2.43408015422750479e-01,
+   2.46339863501263995e-01, 2.49284212418528578e-01, 2.52241126055942233e-01, 2.55210669954661962e-01,
+   2.58192911337619235e-01, 2.61187919132721214e-01, 2.64195763997261190e-01, 2.67216518343561471e-01,
+   2.70250256365875463e-01, 2.73297054068577072e-01, 2.76356989295668320e-01, 2.79430141761637940e-01,
+   2.82516593083707579e-01, 2.85616426815501756e-01, 2.88729728482182924e-01, 2.91856585617095210e-01,
+   2.94997087799961810e-01, 2.98151326696685481e-01, 3.01319396100803050e-01, 3.04501391976649993e-01,
+   3.07697412504292056e-01, 3.10907558126286510e-01, 3.14131931596337177e-01, 3.17370638029913610e-01,
+   3.20623784956905356e-01, 3.23891482376391093e-01, 3.27173842813601401e-01, 3.30470981379163586e-01,
+   3.33783015830718455e-01, 3.37110066637006045e-01, 3.40452257044521867e-01, 3.43809713146850715e-01,
+   3.47182563956793644e-01, 3.50570941481406106e-01, 3.53974980800076777e-01, 3.57394820145780501e-01,
+   3.60830600989648032e-01, 3.64282468129004056e-01, 3.67750569779032588e-01, 3.71235057668239554e-01,
+   3.74736087137891249e-01, 3.78253817245619295e-01, 3.81788410873393769e-01, 3.85340034840077450e-01,
+   3.88908860018788938e-01, 3.92495061459315842e-01, 3.96098818515832729e-01, 3.99720314980197555e-01,
+   4.03359739221114844e-01, 4.07017284329473761e-01, 4.10693148270188657e-01, 4.14387534040891625e-01,
+   4.18100649837848615e-01, 4.21832709229496339e-01, 4.25583931338022414e-01, 4.29354541029441927e-01,
+   4.33144769112652761e-01, 4.36954852547985995e-01, 4.40785034665804376e-01, 4.44635565395739785e-01,
+   4.48506701507203398e-01, 4.52398706861848965e-01, 4.56311852678716767e-01, 4.60246417812843200e-01,
+   4.64202689048174633e-01, 4.68180961405693874e-01, 4.72181538467730422e-01, 4.76204732719506141e-01,
+   4.80250865909047031e-01, 4.84320269426683603e-01, 4.88413284705458306e-01, 4.92530263643868815e-01,
+   4.96671569052490103e-01, 5.00837575126149126e-01, 5.05028667943468457e-01, 5.09245245995748164e-01,
+   5.13487720747327181e-01, 5.17756517229756463e-01, 5.22052074672321953e-01, 5.26374847171684590e-01,
+   5.30725304403662279e-01, 5.35103932380457947e-01, 5.39511234256952577e-01, 5.43947731190026706e-01,
+   5.48413963255266368e-01, 5.52910490425832957e-01, 5.57437893618766611e-01, 5.61996775814525118e-01,
+   5.66587763256165000e-01, 5.71211506735253782e-01, 5.75868682972354273e-01, 5.80559996100791453e-01,
+   5.85286179263371786e-01, 5.90047996332826230e-01, 5.94846243767987670e-01, 5.99681752619125596e-01,
+   6.04555390697467998e-01, 6.09468064925773656e-01, 6.14420723888914111e-01, 6.19414360605834546e-01,
+   6.24450015547026727e-01, 6.29528779924836912e-01, 6.34651799287623830e-01, 6.39820277453056807e-01,
+   6.45035480820822626e-01, 6.50298743110817035e-01, 6.55611470579697597e-01, 6.60975147776663441e-01,
+   6.66391343908750433e-01, 6.71861719897082432e-01, 6.77388036218773748e-01, 6.82972161644995079e-01,
+   6.88616083004672030e-01, 6.94321916126116934e-01, 7.00091918136511837e-01, 7.05928501332754532e-01,
+   7.11834248878248643e-01, 7.17811932630722183e-01, 7.23864533468630444e-01, 7.29995264561476453e-01,
+   7.36207598126862983e-01, 7.42505296340151388e-01, 7.48892447219157154e-01, 7.55373506507096448e-01,
+   7.61953346836795498e-01, 7.68637315798486487e-01, 7.75431304981187397e-01, 7.82341832654802727e-01,
+   7.89376143566024924e-01, 7.96542330422959299e-01, 8.03849483170964718e-01, 8.11307874312656718e-01,
+   8.18929191603702922e-01, 8.26726833946222039e-01, 8.34716292986884101e-01, 8.42915653112204843e-01,
+   8.51346258458678617e-01, 8.60033621196332199e-01, 8.69008688036857713e-01, 8.78309655808918066e-01,
+   8.87984660755834154e-01, 8.98095921898344307e-01, 9.08726440052131768e-01, 9.19991505039348012e-01,
+   9.32060075959231571e-01, 9.45198953442300871e-01, 9.59879091800108109e-01, 9.77101701267673373e-01,
+   1.00000000000000000e+00
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Ziggurat tables for exp(-x) with 256 layers of equal area.
+// Layer i covers x < x_i with x_0 = v/f(r), x_1 = r and x_256 = 0.
+//    zig_exp_k: 2^53 x_(i+1)/x_i, below the number lies inside the curve
+//    zig_exp_w: x_i/2^53, scales a 53 bit integer to the layer width
+//    zig_exp_f: exp(-x_i)
+/////////////////////////////////////////////////////////////////////////////
+static const unsigned long int zig_exp_k[ZIGLAYERS] = {
+   0x1c5214272497c7ul, 0x1cdb4dd9e4e8c0ul, 0x1dddf62bac0bb1ul, 0x1e5961c78b267cul,
+   0x1ea2a61e122db1ul, 0x1ed38ca188151eul, 0x1ef6aefa57cbe7ul, 0x1f113e047b0414ul,
+   0x1f26143450340aul, 0x1f36e5a38a59a2ul, 0x1f44c7665c6fdbul, 0x1f50724ece1172ul,
+   0x1f5a66904fe3c4ul, 0x1f630000a8e267ul, 0x1f6a8234b7352bul, 0x1f71200f1a241cul,
+   0x1f7700a3582accul, 0x1f7c427839e926ul, 0x1f80fdc336039bul, 0x1f8545f904db8ful,
+   0x1f892aec479607ul, 0x1f8cb99e7385f8ul, 0x1f8ffcda9ae41dul, 0x1f92fda9cef1f3ul,
+   0x1f95c3abd03f79ul, 0x1f98555b782fb9ul, 0x1f9ab84415abc5ul, 0x1f9cf12b79f9bdul,
+   0x1f9f04336bbe0bul, 0x1fa0f4f47df315ul, 0x1fa2c693c5c095ul, 0x1fa47bd48bea00ul,
+   0x1fa61726d1f214ul, 0x1fa79ab3508d3dul, 0x1fa908656f66a2ul, 0x1faa61f399ff28ul,
+   0x1faba8e640060bul, 0x1facde9dbf2d73ul, 0x1fae045767e105ul, 0x1faf1b31c479a7ul,
+   0x1fb0243042e1c2ul, 0x1fb1203e5a9604ul, 0x1fb21032442853ul, 0x1fb2f4cf539c3ful,
+   0x1fb3cec803e747ul, 0x1fb49ebfbf69d2ul, 0x1fb5654c6f37e1ul, 0x1fb622f7d96943ul,
+   0x1fb6d840d55594ul, 0x1fb7859c5b895cul, 0x1fb82b76765b54ul, 0x1fb8ca33174a17ul,
+   0x1fb9622ed4abfcul, 0x1fb9f3bf92b619ul, 0x1fba7f351a70adul, 0x1fbb04d9a0d18dul,
+   0x1fbb84f23fe6a2ul, 0x1fbbffbf63b7aaul, 0x1fbc757d2c4de5ul, 0x1fbce663c6201bul,
+   0x1fbd52a7b9f826ul, 0x1fbdba7a354408ul, 0x1fbe1e094ba614ul, 0x1fbe7d80327ddbul,
+   0x1fbed907770cc6ul, 0x1fbf30c52fc60bul, 0x1fbf84dd29488ful, 0x1fbfd5710f72b9ul,
+   0x1fc022a092f365ul, 0x1fc06c898baff1ul, 0x1fc0b348184da4ul, 0x1fc0f6f6bb2415ul,
+   0x1fc137ae74d6b7ul, 0x1fc17586dccd10ul, 0x1fc1b09637bb3cul, 0x1fc1e8f18c6756ul,
+   0x1fc21eacb6d39eul, 0x1fc251da79f164ul, 0x1fc2828c8ffcf0ul, 0x1fc2b0d3b99f9eul,
+   0x1fc2dcbfcbf263ul, 0x1fc3065fbd7888ul, 0x1fc32dc1b22819ul, 0x1fc352f3069371ul,
+   0x1fc376005a4593ul, 0x1fc396f599614cul, 0x1fc3b5de0591b4ul, 0x1fc3d2c43e593cul,
+   0x1fc3edb248cb62ul, 0x1fc406b196bbf7ul, 0x1fc41dcb0d6e0eul, 0x1fc433070bcb99ul,
+   0x1fc4466d702e21ul, 0x1fc458059dc037ul, 0x1fc467d6817e83ul, 0x1fc475e696dee6ul,
+   0x1fc4823bec237aul, 0x1fc48cdc265ec1ul, 0x1fc495cc852df5ul, 0x1fc49d11e62de3ul,
+   0x1fc4a2b0c82e75ul, 0x1fc4a6ad4e28a0ul, 0x1fc4a90b41fa34ul, 0x1fc4a9ce16ea9ful,
+   0x1fc4a8f8ebfb8cul, 0x1fc4a68e8e07fcul, 0x1fc4a29179b433ul, 0x1fc49d03dd30b1ul,
+   0x1fc495e799d21bul, 0x1fc48d3e457ff6ul, 0x1fc483092bfbb9ul, 0x1fc477495001b2ul,
+   0x1fc469ff6c4504ul, 0x1fc45b2bf447e8ul, 0x1fc44acf15112aul, 0x1fc438e8b5bfc7ul,
+   0x1fc4257877fd68ul, 0x1fc4107db85061ul, 0x1fc3f9f78e4da8ul, 0x1fc3e1e4ccab40ul,
+   0x1fc3c844013349ul, 0x1fc3ad137497faul, 0x1fc390512a2887ul, 0x1fc371fadf66f8ul,
+   0x1fc3520e0b7ec7ul, 0x1fc33087de9c0ful, 0x1fc30d654122edul, 0x1fc2e8a2d2c6b4ul,
+   0x1fc2c23ce98046ul, 0x1fc29a2f90630ful, 0x1fc27076864fc2ul, 0x1fc2450d3c83fful,
+   0x1fc217eed505deul, 0x1fc1e91620ea43ul, 0x1fc1b87d9e74b4ul, 0x1fc1861f770f4bul,
+   0x1fc151f57d1943ul, 0x1fc11bf9298a64ul, 0x1fc0e42399698aul, 0x1fc0aa6d8b1427ul,
+   0x1fc06ecf5b54b3ul, 0x1fc03141024589ul, 0x1fbff1ba0ffdb0ul, 0x1fbfb031a904c4ul,
+   0x1fbf6c9e828ae3ul, 0x1fbf26f6de6175ul, 0x1fbedf3086b128ul, 0x1fbe9540c9695ful,
+   0x1fbe491c7364deul, 0x1fbdfab7cb3f41ul, 0x1fbdaa068bd66bul, 0x1fbd56fbde729cul,
+   0x1fbd018a548f9ful, 0x1fbca9a3e140d5ul, 0x1fbc4f39d22995ul, 0x1fbbf23cc8029eul,
+   0x1fbb929caea4e2ul, 0x1fbb3048b49145ul, 0x1fbacb2f41ec17ul, 0x1fba633deee286ul,
+   0x1fb9f861796f27ul, 0x1fb98a85ba7204ul, 0x1fb919959a0f74ul, 0x1fb8a57b0347f6ul,
+   0x1fb82e1ed6ba09ul, 0x1fb7b368dc7da8ul, 0x1fb7353fb50799ul, 0x1fb6b388c9010aul,
+   0x1fb62e2837fe59ul, 0x1fb5a500c5fdaaul, 0x1fb517f3c793fdul, 0x1fb486e10cacd7ul,
+   0x1fb3f1a6c9be0cul, 0x1fb358217f4e18ul, 0x1fb2ba2bdfa84bul, 0x1fb2179eb2963aul,
+   0x1fb17050b6f1fbul, 0x1fb0c41681dff4ul, 0x1fb012c25b7a13ul, 0x1faf5c2418b07eul,
+   0x1faea008f21d6dul, 0x1fadde3b5782c1ul, 0x1fad1682bf9fe9ul, 0x1fac48a3740585ul,
+   0x1fab745e588232ul, 0x1faa9970adb858ul, 0x1fa9b793ce5feful, 0x1fa8ce7ce6a875ul,
+   0x1fa7dddca51ec4ul, 0x1fa6e55ee46783ul, 0x1fa5e4aa4d097dul, 0x1fa4db5fee6aa3ul,
+   0x1fa3c91ace0683ul, 0x1fa2ad6f6bc4fcul, 0x1fa187eb3a3339ul, 0x1fa058140936c0ul,
+   0x1f9f1d6761a1ceul, 0x1f9dd759cfd803ul, 0x1f9c85561b717aul, 0x1f9b26bc697f00ul,
+   0x1f99bae146ba81ul, 0x1f98410c968892ul, 0x1f96b878633892ul, 0x1f95204f8b64dbul,
+   0x1f9377ac47afd8ul, 0x1f91bd968358e1ul, 0x1f8ff102013e17ul, 0x1f8e10cc45d04aul,
+   0x1f8c1bba3d39adul, 0x1f8a10759374faul, 0x1f87ed89b24262ul, 0x1f85b16056b913ul,
+   0x1f835a3dad9162ul, 0x1f80e63be21139ul, 0x1f7e5346079f8aul, 0x1f7b9f12413ff5ul,
+   0x1f78c71b045cc0ul, 0x1f75c8974d09d7ul, 0x1f72a07190f13aul, 0x1f6f4b3d32e4f4ul,
+   0x1f6bc52a2b02e7ul, 0x1f6809f6859679ul, 0x1f6414dd445772ul, 0x1f5fe08210d08cul,
+   0x1f5b66d9099996ul, 0x1f56a109c3ecc0ul, 0x1f51874c5c3322ul, 0x1f4c10bf1d3a0ful,
+   0x1f463332d788fbul, 0x1f3fe2eb6e694cul, 0x1f39125157c106ul, 0x1f31b18fb95532ul,
+   0x1f29ae1951a874ul, 0x1f20f20c452571ul, 0x1f176369f1f77aul, 0x1f0ce313a796b7ul,
+   0x1f014b76ddd4a4ul, 0x1ef46eca361cd0ul, 0x1ee614ae6e5688ul, 0x1ed5f6f08799ceul,
+   0x1ec3bd07b46557ul, 0x1eaef5b14ef09eul, 0x1e970daf08ae3eul, 0x1e7b42096f046cul,
+   0x1e5a8b177cb7a3ul, 0x1e337b71d47837ul, 0x1e0409dfac9dc9ul, 0x1dc934dd172c71ul,
+   0x1d7e5bd56b18b3ul, 0x1d1bfe2d5c3973ul, 0x1c951d0f88651bul, 0x1bd127f719447cul,
+   0x1a9bb7320eb0aeul, 0x186ef58e3f3c10ul, 0x137d5bd79c317ful, 0x00000000000000ul
+};
+
+static const double zig_exp_w[ZIGLAYERS] = {
+   9.65574006320918298e-16, 8.54551703858402742e-16, 7.70609535003209675e-16, 7.19244496608936156e-16,
+   6.82139307902892863e-16, 6.53049205356404080e-16, 6.29097903487755705e-16, 6.08723141618090767e-16,
+   5.90981764165210300e-16, 5.75260648150333169e-16, 5.61138745467515962e-16, 5.48314403425870391e-16,
+   5.36564097711202162e-16, 5.25717580202227484e-16, 5.15642182887808295e-16, 5.06232507214415970e-16,
+   4.97403423619193975e-16, 4.89085182739220990e-16, 4.81219917282923793e-16, 4.73759085326249203e-16,
+   4.66661566471147578e-16, 4.59892220490593247e-16, 4.53420779856583448e-16, 4.47220987425993228e-16,
+   4.41269916903606990e-16, 4.35547431469395201e-16, 4.30035748166747070e-16, 4.24719084182438505e-16,
+   4.19583367207339893e-16, 4.14615996429090458e-16, 4.09805643890306251e-16, 4.05142088295657318e-16,
+   4.00616075105654169e-16, 3.96219198078677500e-16, 3.91943798431142887e-16, 3.87782878560789529e-16,
+   3.83730027878921369e-16, 3.79779358766887439e-16, 3.75925451041625653e-16, 3.72163303608020729e-16,
+   3.68488292209562132e-16, 3.64896132376454255e-16, 3.61382846821906059e-16, 3.57944736660427654e-16,
+   3.54578355922479186e-16, 3.51280488922297942e-16, 3.48048130103744229e-16, 3.44878466045342389e-16,
+   3.41768859352563700e-16, 3.38716834204550516e-16, 3.35720063355324408e-16, 3.32776356417167141e-16,
+   3.29883649277228315e-16, 3.27039994518224044e-16, 3.24243552730945164e-16, 3.21492584620679736e-16,
+   3.18785443821971312e-16, 3.16120570346710573e-16, 3.13496484599666312e-16, 3.10911781903426634e-16,
+   3.08365127481531000e-16, 3.05855251854486087e-16, 3.03380946608500342e-16, 3.00941060501261814e-16,
+   2.98534495873004528e-16, 2.96160205334546569e-16, 2.93817188707002863e-16, 2.91504490190529318e-16,
+   2.89221195741799560e-16, 2.86966430641981768e-16, 2.84739357238817409e-16, 2.82539172848025318e-16,
+   2.80365107800698346e-16, 2.78216423624643608e-16, 2.76092411348761713e-16, 2.73992389920581482e-16,
+   2.71915704727981850e-16, 2.69861726216948893e-16, 2.67829848597952517e-16, 2.65819488634184512e-16,
+   2.63830084505494282e-16, 2.61861094742392422e-16, 2.59911997224974692e-16, 2.57982288242053090e-16,
+   2.56071481606177076e-16, 2.54179107820581223e-16, 2.52304713294421701e-16, 2.50447859602955704e-16,
+   2.48608122789585172e-16, 2.46785092706928874e-16, 2.44978372394307022e-16, 2.43187577489225596e-16,
+   2.41412335670629328e-16, 2.39652286131862352e-16, 2.37907079081427670e-16, 2.36176375269777399e-16,
+   2.34459845540495786e-16, 2.32757170404353461e-16, 2.31068039634821332e-16, 2.29392151883731135e-16,
+   2.27729214315862104e-16, 2.26078942261317374e-16, 2.24441058884630859e-16, 2.22815294869618055e-16,
+   2.21201388119049594e-16, 2.19599083468287073e-16, 2.18008132412078403e-16, 2.16428292843760472e-16,
+   2.14859328806166332e-16, 2.13301010253577909e-16, 2.11753112824107591e-16, 2.10215417621929279e-16,
+   2.08687711008815972e-16, 2.07169784404473703e-16, 2.05661434095191787e-16, 2.04162461050358877e-16,
+   2.02672670746419829e-16, 2.01191872997873467e-16, 1.99719881794934208e-16, 1.98256515147501905e-16,
+   1.96801594935103738e-16, 1.95354946762490913e-16, 1.93916399820589942e-16, 1.92485786752524382e-16,
+   1.91062943524437654e-16, 1.89647709300861672e-16, 1.88239926324389205e-16, 1.86839439799419268e-16,
+   1.85446097779756946e-16, 1.84059751059858783e-16, 1.82680253069525227e-16, 1.81307459771850156e-16,
+   1.79941229564246372e-16, 1.78581423182373262e-16, 1.77227903606800649e-16, 1.75880535972249138e-16,
+   1.74539187479253398e-16, 1.73203727308100837e-16, 1.71874026534903166e-16, 1.70549958049662983e-16,
+   1.69231396476202227e-16, 1.67918218093822886e-16, 1.66610300760574207e-16, 1.65307523838003691e-16,
+   1.64009768117271795e-16, 1.62716915746513050e-16, 1.61428850159327866e-16, 1.60145456004291673e-16,
+   1.58866619075368415e-16, 1.57592226243117614e-16, 1.56322165386583750e-16, 1.55056325325757715e-16,
+   1.53794595754499693e-16, 1.52536867173812555e-16, 1.51283030825353943e-16, 1.50032978625073695e-16,
+   1.48786603096862607e-16, 1.47543797306095163e-16, 1.46304454792947572e-16, 1.45068469505368768e-16,
+   1.43835735731579018e-16, 1.42606148031966544e-16, 1.41379601170248519e-16, 1.40155990043757154e-16,
+   1.38935209612706392e-16, 1.37717154828288096e-16, 1.36501720559439777e-16, 1.35288801518117546e-16,
+   1.34078292182899943e-16, 1.32870086720738089e-16, 1.31664078906657258e-16, 1.30460162041202885e-16,
+   1.29258228865411955e-16, 1.28058171473074938e-16, 1.26859881220039754e-16, 1.25663248630289851e-16,
+   1.24468163298511252e-16, 1.23274513788841519e-16, 1.22082187529470615e-16, 1.20891070702738552e-16,
+   1.19701048130346516e-16, 1.18512003153266943e-16, 1.17323817505904579e-16, 1.16136371184021831e-16,
+   1.14949542305900930e-16, 1.13763206966168471e-16, 1.12577239081656749e-16, 1.11391510228619750e-16,
+   1.10205889470557811e-16, 1.09020243175835047e-16, 1.07834434824194850e-16, 1.06648324801191470e-16,
+   1.05461770179457641e-16, 1.04274624485618856e-16, 1.03086737451542195e-16, 1.01897954748469408e-16,
+   1.00708117702429493e-16, 9.95170629891507188e-17, 9.83246223064951136e-17, 9.71306220222152121e-17,
+   9.59348827945799732e-17, 9.47372191631294957e-17, 9.35374391064912894e-17, 9.23353435638178812e-17,
+   9.11307259159790917e-17, 8.99233714221535707e-17, 8.87130566069025228e-17, 8.74995485921618251e-17,
+   8.62826043678411300e-17, 8.50619699938532313e-17, 8.38373797253913938e-17, 8.26085550521003817e-17,
+   8.13752036404176221e-17, 8.01370181667545443e-17, 7.88936750272979055e-17, 7.76448329079784810e-17,
+   7.63901311955082579e-17, 7.51291882072372809e-17, 7.38615992138179200e-17, 7.25869342241464835e-17,
+   7.13047354966064341e-17, 7.00145147340392962e-17, 6.87157499118381244e-17, 6.74078816787272224e-17,
+   6.60903092576940524e-17, 6.47623857595614212e-17, 6.34234128030307651e-17, 6.20726343116319349e-17,
+   6.07092293284717957e-17, 5.93323036520894308e-17, 5.79408800485276662e-17, 5.65338867323966713e-17,
+   5.51101437283509472e-17, 5.36683466171819218e-17, 5.22070470279267174e-17, 5.07246290450314701e-17,
+   4.92192804372796285e-17, 4.76889572526463594e-17, 4.61313398148318593e-17, 4.45437774328237142e-17,
+   4.29232180844252563e-17, 4.12661177817594643e-17, 3.95683219809755323e-17, 3.78249077686964905e-17,
+   3.60299697873445249e-17, 3.41763234018502703e-17, 3.22550825483637528e-17, 3.02550413032138233e-17,
+   2.81617355419775234e-17, 2.59559577231089395e-17, 2.36112807784313820e-17, 2.10896510946448663e-17,
+   1.83328488572374392e-17, 1.52439151235321602e-17, 1.16394124966912238e-17, 7.08901424395541433e-18
+};
+
+static const double zig_exp_f[ZIGLAYERS+1] = {
+   1.67066692307963889e-04, 4.54134353841496765e-04, 9.67269282327174536e-04, 1.53629978030157236e-03,
+   2.14596774371890626e-03, 2.78879879357407613e-03, 3.46026477783690405e-03, 4.15729512083379531e-03,
+   4.87765598354239233e-03, 5.61964220720548302e-03, 6.38190593731917909e-03, 7.16335318363498386e-03,
+   7.96307743801704000e-03, 8.78031498580897525e-03, 9.61441364250220989e-03, 1.04648101810299789e-02,
+   1.13310135978345970e-02, 1.22125924262553812e-02, 1.31091649312549911e-02, 1.40203914031819376e-02,
+   1.49459680116911485e-02, 1.58856218399731630e-02, 1.68391068260399478e-02, 1.78062004109113617e-02,
+   1.87867007446960305e-02, 1.97804243380097430e-02, 2.07872040725781172e-02, 2.18068875042835807e-02,
+   2.28393354063852402e-02, 2.38844205115581708e-02, 2.49420264197317831e-02, 2.60120466451342174e-02,
+   2.70943837809557997e-02, 2.81889487639786357e-02, 2.92956602246373932e-02, 3.04144439104666042e-02,
+   3.15452321728936086e-02, 3.26879635089595347e-02, 3.38425821508743299e-02, 3.50090376973974104e-02,
+   3.61872847819314225e-02, 3.73772827729593610e-02, 3.85789955030748574e-02, 3.97923910233741254e-02,
+   4.10174413804148194e-02, 4.22541224133162335e-02, 4.35024135688881833e-02, 4.47622977329432820e-02,
+   4.60337610761751698e-02, 4.73167929131815476e-02, 4.86113855733794967e-02, 4.99175342827063717e-02,
+   5.12352370551262815e-02, 5.25644945930716923e-02, 5.39053101960460870e-02, 5.52576896766970374e-02,
+   5.66216412837428767e-02, 5.79971756312006592e-02, 5.93843056334202660e-02, 6.07830464454796326e-02,
+   6.21934154085409946e-02, 6.36154319998073342e-02, 6.50491177867537490e-02, 6.64944963853397741e-02,
+   6.79515934219366013e-02, 6.94204364987287548e-02, 7.09010551623718288e-02, 7.23934808757087378e-02,
+   7.38977469923647462e-02, 7.54138887340584096e-02, 7.69419431704805035e-02, 7.84819492016064213e-02,
+   8.00339475423199054e-02, 8.15979807092374193e-02, 8.31740930096323827e-02, 8.47623305323681187e-02,
+   8.63627411407569129e-02, 8.79753744672702176e-02, 8.96002819100328585e-02, 9.12375166310401553e-02,
+   9.28871335560435413e-02, 9.45491893760558588e-02, 9.62237425504327976e-02, 9.79108533114921992e-02,
+   9.96105836706371317e-02, 1.01322997425953631e-01, 1.03048160171257716e-01, 1.04786139306570172e-01,
+   1.06537004050001660e-01, 1.08300825451033797e-01, 1.10077676405185385e-01, 1.11867631670056297e-01,
+   1.13670767882744314e-01, 1.15487163578633534e-01, 1.17316899211555567e-01, 1.19160057175327683e-01,
+   1.21016721826674833e-01, 1.22886979509545136e-01, 1.24770918580830961e-01, 1.26668629437510671e-01,
+   1.28580204545228172e-01, 1.30505738468330773e-01, 1.32445327901387522e-01, 1.34399071702213629e-01,
+   1.36367070926428857e-01, 1.38349428863580204e-01, 1.40346251074862455e-01, 1.42357645432472202e-01,
+   1.44383722160634775e-01, 1.46424593878344944e-01, 1.48480375643866791e-01, 1.50551185001039894e-01,
+   1.52637142027442857e-01, 1.54738369384468083e-01, 1.56854992369365231e-01, 1.58987138969314212e-01,
+   1.61134939917592035e-01, 1.63298528751901817e-01, 1.65478041874936005e-01, 1.67673618617250192e-01,
+   1.69885401302527661e-01, 1.72113535315320060e-01, 1.74358169171353494e-01, 1.76619454590494884e-01,
+   1.78897546572478305e-01, 1.81192603475496289e-01, 1.83504787097767463e-01, 1.85834262762197111e-01,
+   1.88181199404254318e-01, 1.90545769663195391e-01, 1.92928149976771351e-01, 1.95328520679563217e-01,
+   1.97747066105098873e-01, 2.00183974691911265e-01, 2.02639439093709017e-01, 2.05113656293837709e-01,
+   2.07606827724222037e-01, 2.10119159388988258e-01, 2.12650861992978280e-01, 2.15202151075378684e-01,
+   2.17773247148700527e-01, 2.20364375843359495e-01, 2.22975768058120194e-01, 2.25607660116684067e-01,
+   2.28260293930716701e-01, 2.30933917169627412e-01, 2.33628783437433346e-01, 2.36345152457059643e-01,
+   2.39083290262449177e-01, 2.41843469398877214e-01, 2.44625969131892107e-01, 2.47431075665327627e-01,
+   2.50259082368862296e-01, 2.53110290015629458e-01, 2.55985007030415379e-01, 2.58883549749016229e-01,
+   2.61806242689362978e-01, 2.64753418835062204e-01, 2.67725419932044795e-01, 2.70722596799060022e-01,
+   2.73745309652802971e-01, 2.76793928448517357e-01, 2.79868833236972925e-01, 2.82970414538780746e-01,
+   2.86099073737076826e-01, 2.89255223489677749e-01, 2.92439288161892574e-01, 2.95651704281261196e-01,
+   2.98892921015581792e-01, 3.02163400675693528e-01, 3.05463619244590256e-01, 3.08794066934560185e-01,
+   3.12155248774179550e-01, 3.15547685227128949e-01, 3.18971912844957239e-01, 3.22428484956089167e-01,
+   3.25917972393556188e-01, 3.29440964264136327e-01, 3.32998068761808985e-01, 3.36589914028677606e-01,
+   3.40217149066780022e-01, 3.43880444704502408e-01, 3.47580494621636982e-01, 3.51318016437483338e-01,
+   3.55093752866787460e-01, 3.58908472948749779e-01, 3.62762973354817775e-01, 3.66658079781514157e-01,
+   3.70594648435146001e-01, 3.74573567615902159e-01, 3.78595759409580790e-01, 3.82662181496009834e-01,
+   3.86773829084137655e-01, 3.90931736984797107e-01, 3.95136981833290157e-01, 3.99390684475231073e-01,
+   4.03694012530530277e-01, 4.08048183152032395e-01, 4.12454465997161179e-01, 4.16914186433002876e-01,
+   4.21428728997616575e-01, 4.25999541143034344e-01, 4.30628137288458834e-01, 4.35316103215636574e-01,
+   4.40065100842353896e-01, 4.44876873414548513e-01, 4.49753251162754997e-01, 4.54696157474615503e-01,
+   4.59707615642137690e-01, 4.64789756250426178e-01, 4.69944825283959977e-01, 4.75175193037377375e-01,
+   4.80483363930454210e-01, 4.85871987341884914e-01, 4.91343869594032534e-01, 4.96901987241549548e-01,
+   5.02549501841347723e-01, 5.08289776410642880e-01, 5.14126393814748561e-01, 5.20063177368233598e-01,
+   5.26104213983619728e-01, 5.32253880263043322e-01, 5.38516872002861913e-01, 5.44898237672439612e-01,
+   5.51403416540641289e-01, 5.58038282262587448e-01, 5.64809192912400171e-01, 5.71723048664825817e-01,
+   5.78787358602845026e-01, 5.86010318477268033e-01, 5.93400901691733429e-01, 6.00968966365232227e-01,
+   6.08725382079622013e-01, 6.16682180915207656e-01, 6.24852738703665977e-01, 6.33251994214366065e-01,
+   6.41896716427266090e-01, 6.50805833414571100e-01, 6.60000841078999700e-01, 6.69506316731924733e-01,
+   6.79350572264765362e-01, 6.89566496117077987e-01, 7.00192655082788162e-01, 7.11274760805076012e-01,
+   7.22867659593572021e-01, 7.35038092431423484e-01, 7.47868621985195103e-01, 7.61463388849896283e-01,
+   7.75956852040115552e-01, 7.91527636972495618e-01, 8.08421651523008378e-01, 8.26993296643050324e-01,
+   8.47785500623989607e-01, 8.71704332381203595e-01, 9.00469929925746482e-01, 9.38143680862174700e-01,
+   1.00000000000000000e+00
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Source of 64 bit random numbers for the ziggurat algorithm.
+//    The buffer is refilled with at most as many numbers as values remain
+//    to be generated. Each value needs at least one number, therefore a
+//    bulk call draws exactly the numbers of repeated single value calls.
+// Variables:
+//    rng_int: Random number generator state
+//    buffer: buffer of random numbers, NULL to draw them one at a time
+//    pos: position of the next number in the buffer
+//    len: number of valid numbers in the buffer
+//    nleft: number of values that still need to be generated
+/////////////////////////////////////////////////////////////////////////////
+typedef struct zig_source_s {
+   rng_int_type* rng_int ;
+   long int* buffer ;
+   size_t pos ;
+   size_t len ;
+   size_t nleft ;
+} zig_source_type;
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Takes the next 64 bit random number from a ziggurat source
+// Variables:
+//    source: ziggurat source
+// Return value:
+//    rng: next random number
+/////////////////////////////////////////////////////////////////////////////
+static inline unsigned long int next_zig_source(zig_source_type* source){
+   if (source->buffer == NULL){
+      return (unsigned long int) next_random_lint(source->rng_int);
+   }
+
+   if (source->pos == source->len){
+      size_t nfill = source->nleft < ZIGBUFFERLENGTH ? source->nleft : ZIGBUFFERLENGTH;
+      fill_random_lint(source->rng_int, source->buffer, nfill);
+      source->pos = 0;
+      source->len = nfill;
+   }
+   return (unsigned long int) source->buffer[source->pos++];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Samples the tail x > r of the normal distribution (Marsaglia 1964)
+// Variables:
+//    source: ziggurat source
+//    negative: Boolean if the sample is to be mirrored
+// Return value:
+//    randnum: standard normal random number with |randnum| > r
+/////////////////////////////////////////////////////////////////////////////
+static double zig_norm_tail(zig_source_type* source, bool negative){
+   double x, y;
+   do {
+      // uniform numbers in (0,1] so that the logarithm is finite
+      x = -log(INV2POW53 * (double)((next_zig_source(source)>>11)+1)) / zig_norm_r;
+      y = -log(INV2POW53 * (double)((next_zig_source(source)>>11)+1));
+   } while (2.0*y < x*x);
+
+   return negative ? -(zig_norm_r + x) : zig_norm_r + x;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates a standard normal random number with the ziggurat algorithm.
+//    One 64 bit number provides the layer (8 bits), the sign (1 bit) and
+//    the position in the layer (52 bits). Only if the position falls
+//    outside of the inner rectangle of its layer the wedge or the tail
+//    has to be sampled.
+// Variables:
+//    source: ziggurat source
+// Return value:
+//    randnum: standard normal random number
+/////////////////////////////////////////////////////////////////////////////
+static inline double zig_norm(zig_source_type* source){
+   for (;;){
+      unsigned long int rng = next_zig_source(source);
+      int idx = (int) (rng & 0xFF);
+      bool negative = (rng >> 8) & 1ul;
+      unsigned long int rabs = (rng >> 9) & MANTISSAMASK;
+
+      double x = (double) rabs * zig_norm_w[idx];
+      if (negative) {x = -x;}
+      if (rabs < zig_norm_k[idx]) {return x;}
+
+      if (idx == 0) {return zig_norm_tail(source, negative);}
+
+      double u = INV2POW53 * (double)(next_zig_source(source)>>11);
+      double y = zig_norm_f[idx] + u*(zig_norm_f[idx+1] - zig_norm_f[idx]);
+      if (y < exp(-0.5*x*x)) {return x;}
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates a standard exponential random number with the ziggurat
+//    algorithm. One 64 bit number provides the layer (8 bits) and the
+//    position in the layer (53 bits). The tail beyond r is again
+//    exponential, so it is sampled by starting over shifted by r.
+// Variables:
+//    source: ziggurat source
+// Return value:
+//    randnum: standard exponential random number
+/////////////////////////////////////////////////////////////////////////////
+static inline double zig_exp(zig_source_type* source){
+   double shift = 0.0;
+   for (;;){
+      unsigned long int rng = next_zig_source(source);
+      int idx = (int) (rng & 0xFF);
+      unsigned long int rabs = rng >> 11;
+
+      double x = (double) rabs * zig_exp_w[idx];
+      if (rabs < zig_exp_k[idx]) {return shift + x;}
+
+      if (idx == 0){
+         shift += zig_exp_r;
+         continue;
+      }
+
+      double u = INV2POW53 * (double)(next_zig_source(source)>>11);
+      double y = zig_exp_f[idx] + u*(zig_exp_f[idx+1] - zig_exp_f[idx]);
+      if (y < exp(-x)) {return shift + x;}
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates a standard normal random number with the ziggurat algorithm
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    randnum: standard normal random number
+/////////////////////////////////////////////////////////////////////////////
+double standard_normal_ziggurat(rng_int_type* rng_int){
+   zig_source_type source = {rng_int, NULL, 0, 0, 1};
+   return zig_norm(&source);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates a standard exponential random number with the ziggurat
+//    algorithm
+// Variables:
+//    rng_int: Random number generator state
+// Return value:
+//    randnum: standard exponential random number
+/////////////////////////////////////////////////////////////////////////////
+double standard_exponential_ziggurat(rng_int_type* rng_int){
+   zig_source_type source = {rng_int, NULL, 0, 0, 1};
+   return zig_exp(&source);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with standard exponential random numbers of the
+//    ziggurat algorithm. The numbers are identical to n consecutive calls
+//    of standard_exponential_ziggurat
+// Variables:
+//    rng_int: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_standard_exponential_ziggurat(rng_int_type* rng_int, double* randnums, size_t n){
+   long int buffer[ZIGBUFFERLENGTH];
+   zig_source_type source = {rng_int, buffer, 0, 0, n};
+
+   for (size_t i=0; i<n; i++){
+      randnums[i] = zig_exp(&source);
+      source.nleft--;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Generates the next gaussian random number with the ziggurat algorithm
+// Variables:
+//    rng_gaussian: Random number generator state
+// Return value:
+//    randnum: next random number
+/////////////////////////////////////////////////////////////////////////////
+double next_random_gaussian_ziggurat(rng_gaussian_type* rng_gaussian){
+   zig_source_type source = {&rng_gaussian->rng_uniform.rng_int, NULL, 0, 0, 1};
+   return zig_norm(&source) * rng_gaussian->stddev + rng_gaussian->mean;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Description:
+//    Fills an array with the next gaussian random numbers of the ziggurat
+//    algorithm. The numbers are identical to n consecutive calls of
+//    next_random_gaussian_ziggurat
+// Variables:
+//    rng_gaussian: Random number generator state
+//    randnums: array to hold the random numbers
+//    n: number of random numbers to generate
+/////////////////////////////////////////////////////////////////////////////
+void fill_random_gaussian_ziggurat(rng_gaussian_type* rng_gaussian, double* randnums, size_t n){
+   long int buffer[ZIGBUFFERLENGTH];
+   zig_source_type source = {&rng_gaussian->rng_uniform.rng_int, buffer, 0, 0, n};
+   const double stddev = rng_gaussian->stddev;
+   const double mean = rng_gaussian->mean;
+
+   for (size_t i=0; i<n; i++){
+      randnums[i] = zig_norm(&source) * stddev + mean;
+      source.nleft--;
+   }
+}
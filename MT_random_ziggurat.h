@@ -0,0 +1,55 @@
+#ifndef MT_RANDOM_ZIGGURAT_H
+#define MT_RANDOM_ZIGGURAT_H
+   ////////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Contains routines to generate gaussian distributed pseudo random numbers
+   //    with the ziggurat algorithm of Marsaglia and Tsang instead of the
+   //    Box-Muller transform. In the common case a number costs a single
+   //    64 bit random number, one table lookup and a comparison.
+   //    The sequence differs from the one of next_random_gaussian.
+   // Usage:
+   //    Import this header:
+   //       #include "MT_random_ziggurat.h"
+   //    Initialize a gaussian random number state as usual:
+   //       rng_stateg = init_rng_gaussian(seed, meanvalue, stddev)
+   //    Get the next random number:
+   //       random_number = next_random_gaussian_ziggurat(&rng_stateg) ;
+   //    Fill an array with the next n random numbers:
+   //       fill_random_gaussian_ziggurat(&rng_stateg, random_numbers, n) ;
+   //    The state can be stored and restored with the gaussian routines.
+   ////////////////////////////////////////////////////////////////////////////////
+
+   #include <stddef.h>
+   #include "MT_random.h"
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Generates the next gaussian random number with the ziggurat algorithm
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   // Return value:
+   //    randnum: next random number
+   /////////////////////////////////////////////////////////////////////////////
+   double next_random_gaussian_ziggurat(rng_gaussian_type* rng_gaussian);
+
+   /////////////////////////////////////////////////////////////////////////////
+   // Description:
+   //    Fills an array with the next gaussian random numbers of the ziggurat
+   //    algorithm. The numbers are identical to n consecutive calls of
+   //    next_random_gaussian_ziggurat
+   // Variables:
+   //    rng_gaussian: Random number generator state
+   //    randnums: array to hold the random numbers
+   //    n: number of random numbers to generate
+   /////////////////////////////////////////////////////////////////////////////
+   void fill_random_gaussian_ziggurat(rng_gaussian_type* rng_gaussian, double* randnums, size_t n);
+
+   #ifdef __cplusplus
+   }
+   #endif
+
+#endif